@@ -4,7 +4,7 @@
 // Created Date: 2026-04-27                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-04-27                                                  //
+// Last Modified: 2026-10-16                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -309,6 +309,9 @@ TimedRunResult TimeOneSample(respond::Model &model,
     model.SetState(initial_state);
     model.ClearHistories();
     model.SetFinalTimestep(steps);
+    if (!model.IsFinalized()) {
+        model.Finalize();
+    }
 
     const auto start = Clock::now();
     for (int i = 0; i < steps; ++i) {
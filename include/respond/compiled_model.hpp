@@ -0,0 +1,419 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: compiled_model.hpp                                                   //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_COMPILED_MODEL_HPP_
+#define RESPOND_COMPILED_MODEL_HPP_
+
+#include <respond/model.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include <respond/dual.hpp>
+#include <respond/history.hpp>
+#include <respond/history_recorder.hpp>
+#include <respond/logging.hpp>
+#include <respond/transition.hpp>
+#include <respond/typed_pipeline.hpp>
+
+namespace respond {
+/// @brief A model that runs its transition chain as a TypedPipeline.
+/// State and histories are stored in the given scalar type and converted to
+/// double only at the Model interface. The chain is validated once, like
+/// Model::Finalize(), the first time it runs after being changed, so the
+/// same assumptions of non-negative populations and probability-valued
+/// matrices apply. Batched execution is not supported.
+/// With a Dual scalar one run also yields the derivatives of the state and
+/// of every history with respect to the entries set by SetSensitivities(),
+/// e.g. for gradient-based calibration.
+/// @tparam Scalar The floating point type states and histories are held in.
+/// @tparam Size The state dimension if known at compile time. A fixed size
+/// model stores its state, matrices and histories in fixed-size Eigen types
+/// and checks dimensions only where values cross the Model interface.
+template <typename Scalar, int Size = Eigen::Dynamic>
+class CompiledModel : public virtual Model {
+public:
+    using Pipeline = TypedPipeline<Scalar, Size>;
+    using Vector = typename Pipeline::Vector;
+    using HistoryMap = typename Pipeline::HistoryMap;
+    using Slots = typename Pipeline::Slots;
+
+    CompiledModel(const std::string &name, const std::string &log_name)
+        : _name(name), _log_name(log_name), _current_timestep(0),
+          _initial_history_recorded(false), _has_state(false),
+          _finalized(false) {}
+
+    ~CompiledModel() = default;
+
+    std::unique_ptr<Model> clone() const override {
+        auto ret = std::make_unique<CompiledModel>(_name, _log_name);
+        ret->_state = _state;
+        ret->_has_state = _has_state;
+        ret->_histories = _histories;
+        ret->_recorder = _recorder;
+        ret->_slots.Resolve(ret->_histories, _recorder.GetSubscribed());
+        ret->_current_timestep = _current_timestep;
+        ret->_initial_history_recorded = _initial_history_recorded;
+        ret->_sensitivities = _sensitivities;
+        for (const auto &t : _transitions) {
+            ret->_transitions.push_back(t->clone());
+        }
+        // custom stages point at our transitions, so only a pipeline without
+        // them can be shared instead of compiled again
+        if (_finalized && !_pipeline.HasCustomStages()) {
+            ret->_pipeline = _pipeline;
+            ret->ReserveRun();
+            ret->_finalized = true;
+        } else if (_finalized) {
+            ret->Finalize();
+        }
+        return ret;
+    }
+
+    void SetState(const Eigen::Ref<const Eigen::VectorXd> &s) override {
+        CheckSize(s.size(), "state");
+        if (!_has_state || s.size() != _state.size() ||
+            (s.array() < 0).any()) {
+            InvalidatePlan();
+        }
+        _state = s.template cast<Scalar>();
+        _has_state = true;
+    }
+    Eigen::VectorXd GetState() const override {
+        if (!_has_state) {
+            return {};
+        }
+        return _state.template cast<double>();
+    }
+
+    void SetBatchState(const Eigen::Ref<const Eigen::MatrixXd> &) override {
+        std::string error_msg = "CompiledModel error: Model '" + _name +
+                                "' does not support batched execution";
+        LogError(_log_name, error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    Eigen::MatrixXd GetBatchState() const override { return {}; }
+    bool IsBatched() const override { return false; }
+    std::vector<std::map<std::string, History>>
+    GetBatchHistories() const override {
+        return {};
+    }
+
+    void RunTransitions() override {
+        SetupHistory();
+        if (!_finalized) {
+            Finalize();
+        }
+        if (!_initial_history_recorded) {
+            RecordHistoryAtCurrentTimestep();
+        }
+        for (const auto &t : _transitions) {
+            t->SelectTimestep(_current_timestep);
+        }
+        _pipeline.Run(_state, _next_state, _histories, _slots,
+                      _current_timestep);
+        _current_timestep++;
+        RecordHistoryAtCurrentTimestep();
+    }
+
+    void Finalize() override {
+        InvalidatePlan();
+        SetupHistory();
+        if (!_has_state || _state.size() == 0) {
+            std::string error_msg =
+                "CompiledModel error: Cannot finalize model '" + _name +
+                "' before a state is set";
+            LogError(_log_name, error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        if ((_state.array() < 0).any()) {
+            std::string error_msg =
+                "CompiledModel error: Cannot finalize model '" + _name +
+                "' with a negative state";
+            LogError(_log_name, error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        ValidateSensitivities();
+        _pipeline.Compile(_transitions, _state.size(), _sensitivities);
+        if (IsDual<Scalar>::value && _pipeline.HasCustomStages()) {
+            _pipeline.Clear();
+            std::string error_msg =
+                "CompiledModel error: Model '" + _name +
+                "' cannot differentiate through custom transitions or "
+                "transitions with change times";
+            LogError(_log_name, error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        ReserveRun();
+        _finalized = true;
+    }
+
+    bool IsFinalized() const override { return _finalized; }
+
+    void AddTransition(const std::unique_ptr<Transition> &t) override {
+        InvalidatePlan();
+        _transitions.push_back(t->clone());
+    }
+    void AddTransition(std::unique_ptr<Transition> &&t) override {
+        InvalidatePlan();
+        _transitions.push_back(std::move(t));
+    }
+    std::vector<std::string> GetTransitionNames() const override {
+        std::vector<std::string> t_names;
+        for (const auto &t : _transitions) {
+            t_names.push_back(t->GetTransitionName());
+        }
+        return t_names;
+    }
+    void ClearTransitions() override {
+        InvalidatePlan();
+        _transitions.clear();
+    }
+
+    std::map<std::string, History> GetHistories() const override {
+        std::map<std::string, History> ret;
+        for (const auto &kv : _histories) {
+            ret.emplace(kv.first, History(kv.second));
+        }
+        return ret;
+    }
+
+    /// @brief The default histories match those of the double precision
+    /// model: state, total and fatal overdoses, intervention admissions and
+    /// background mortality.
+    void CreateDefaultHistories() override {
+        SetHistories(HistoryRecorder::DefaultHistories(_log_name));
+    }
+
+    void SetHistories(const std::map<std::string, History> &h) override {
+        for (const auto &kv : h) {
+            for (const auto &s : kv.second.GetRecordedStates()) {
+                CheckSize(s.size(), "history '" + kv.first + "'");
+            }
+            if (kv.second.HasPendingState()) {
+                CheckSize(kv.second.GetPendingState().size(),
+                          "history '" + kv.first + "'");
+            }
+        }
+        _histories.clear();
+        for (const auto &kv : h) {
+            _histories.emplace(kv.first,
+                               BasicHistory<Scalar, Size>(kv.second));
+        }
+        _recorder.DropUnsubscribed(_histories);
+        ResolveSlots();
+        const int latest_timestep =
+            HistoryRecorder::LatestRecordedTimestep(_histories);
+        if (latest_timestep < 0) {
+            ResetHistoryTracking();
+            return;
+        }
+        _initial_history_recorded = true;
+        _current_timestep = latest_timestep;
+    }
+    void ClearHistories() override {
+        _histories.clear();
+        ResolveSlots();
+        ResetHistoryTracking();
+    }
+
+    void SetSubscribedChannels(
+        const std::vector<HistoryChannel> &channels) override {
+        _recorder.SetSubscribedChannels(channels);
+        _recorder.DropUnsubscribed(_histories);
+        ResolveSlots();
+    }
+    std::vector<HistoryChannel> GetSubscribedChannels() const override {
+        return _recorder.GetSubscribedChannels();
+    }
+
+    void SetHistoryCaptureInterval(int interval) override {
+        _recorder.SetCaptureInterval(interval);
+    }
+    int GetHistoryCaptureInterval() const override {
+        return _recorder.GetCaptureInterval();
+    }
+    void SetFinalTimestep(int final_timestep) override {
+        _recorder.SetFinalTimestep(final_timestep);
+    }
+    int GetFinalTimestep() const override {
+        return _recorder.GetFinalTimestep();
+    }
+
+    std::string GetModelName() const override { return _name; }
+    std::string GetLogName() const override { return _log_name; }
+
+    /// @brief Retrieves the histories at their stored precision.
+    /// @return Const reference to the typed history records.
+    const HistoryMap &GetTypedHistories() const { return _histories; }
+
+    /// @brief Retrieves the state at its stored precision, e.g. to read the
+    /// derivatives of a dual-valued model.
+    /// @return Const reference to the typed state.
+    const Vector &GetTypedState() const { return _state; }
+
+    /// @brief Selects the transition matrix entries a dual-valued model
+    /// differentiates by; entry i is derivative direction i. The entries are
+    /// checked against the chain when the model is finalized.
+    /// @param entries At most Scalar::kDirections entries.
+    /// @throws std::runtime_error if the scalar is not a Dual or there are
+    /// more entries than directions.
+    void SetSensitivities(const std::vector<SensitivityEntry> &entries) {
+        if constexpr (IsDual<Scalar>::value) {
+            if (entries.size() <=
+                static_cast<std::size_t>(Scalar::kDirections)) {
+                InvalidatePlan();
+                _sensitivities = entries;
+                return;
+            }
+        }
+        std::string error_msg =
+            "CompiledModel error: Model '" + _name + "' can carry " +
+            std::to_string(Directions()) + " derivative directions but " +
+            std::to_string(entries.size()) + " sensitivities were requested";
+        LogError(_log_name, error_msg);
+        throw std::runtime_error(error_msg);
+    }
+
+    /// @brief Retrieves the entries the model differentiates by.
+    /// @return The entries in direction order.
+    const std::vector<SensitivityEntry> &GetSensitivities() const {
+        return _sensitivities;
+    }
+
+private:
+    std::vector<std::unique_ptr<Transition>> _transitions;
+    Pipeline _pipeline;
+    Vector _state;
+    Vector _next_state;
+    std::string _name;
+    std::string _log_name;
+    HistoryMap _histories;
+    Slots _slots;
+    HistoryRecorder _recorder;
+    std::vector<SensitivityEntry> _sensitivities;
+    int _current_timestep;
+    bool _initial_history_recorded;
+    // fixed size states cannot be empty, so track whether one was set
+    bool _has_state;
+    bool _finalized;
+
+    // values entering a fixed size model must have its compile-time size
+    void CheckSize(Eigen::Index size, const std::string &what) const {
+        if (Size != Eigen::Dynamic && size != Size) {
+            std::string error_msg = "CompiledModel error: Model '" + _name +
+                                    "' has a fixed size of " +
+                                    std::to_string(Size) + " but the " +
+                                    what + " has size " + std::to_string(size);
+            LogError(_log_name, error_msg);
+            throw std::runtime_error(error_msg);
+        }
+    }
+
+    // custom stages record through histories bound to the map's entries
+    void ResolveSlots() {
+        _slots.Resolve(_histories, _recorder.GetSubscribed());
+        if (_pipeline.HasCustomStages()) {
+            _pipeline.BindHistories(_histories);
+        }
+    }
+
+    void InvalidatePlan() {
+        _finalized = false;
+        _pipeline.Clear();
+    }
+
+    static constexpr int Directions() {
+        if constexpr (IsDual<Scalar>::value) {
+            return Scalar::kDirections;
+        }
+        return 0;
+    }
+
+    // sensitivities must name existing entries of the current chain
+    void ValidateSensitivities() const {
+        for (const auto &entry : _sensitivities) {
+            bool found = entry.transition < _transitions.size();
+            if (found) {
+                const auto matrices =
+                    _transitions[entry.transition]->CopyTransitionMatrices();
+                found = entry.matrix < matrices.size() && entry.row >= 0 &&
+                        entry.col >= 0 &&
+                        entry.row < matrices[entry.matrix].rows() &&
+                        entry.col < matrices[entry.matrix].cols();
+            }
+            if (!found) {
+                std::string error_msg =
+                    "CompiledModel error: Model '" + _name +
+                    "' has no entry (" + std::to_string(entry.row) + ", " +
+                    std::to_string(entry.col) + ") in matrix " +
+                    std::to_string(entry.matrix) + " of transition " +
+                    std::to_string(entry.transition);
+                LogError(_log_name, error_msg);
+                throw std::runtime_error(error_msg);
+            }
+        }
+    }
+
+    // the step buffer and history storage are sized once, like Markov's
+    void ReserveRun() {
+        _next_state.resize(_state.size());
+        const std::size_t records = _recorder.RecordsFrom(_current_timestep);
+        for (auto &kv : _histories) {
+            kv.second.Reserve(records, _state.size());
+        }
+    }
+
+    void ResetHistoryTracking() {
+        _current_timestep = 0;
+        _initial_history_recorded = false;
+    }
+
+    void RecordHistoryAtCurrentTimestep() {
+        if (_initial_history_recorded && _current_timestep == 0) {
+            return;
+        }
+        if (!_recorder.ShouldRecord(_current_timestep)) {
+            return;
+        }
+        // custom stages record through histories bound to the map's entries
+        if (_recorder.Record(_histories, _slots, _state, _current_timestep) &&
+            _pipeline.HasCustomStages()) {
+            _pipeline.BindHistories(_histories);
+        }
+        _initial_history_recorded = true;
+    }
+
+    void SetupHistory() {
+        if (_histories.empty() && _recorder.GetSubscribed().any()) {
+            CreateDefaultHistories();
+        }
+    }
+};
+
+template <int Size>
+std::unique_ptr<Model> Model::Create(const std::string &name,
+                                     const std::string &log_name,
+                                     Precision precision) {
+    if (precision == Precision::kSingle) {
+        return std::make_unique<CompiledModel<float, Size>>(name, log_name);
+    }
+    return std::make_unique<CompiledModel<double, Size>>(name, log_name);
+}
+} // namespace respond
+
+#endif // RESPOND_COMPILED_MODEL_HPP_
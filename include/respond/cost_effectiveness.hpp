@@ -62,9 +62,10 @@ CwiseMin(const Eigen::Ref<const Eigen::VectorXd> &state,
 /// @param provideDiscount Flag to indicate whether to apply discounting.
 /// @param discountRate Discount rate to apply if discounting is enabled.
 /// @return The total life years calculated from the state history.
-inline double CalculateLifeYears(const History &h, bool discount = false,
-                                 double discount_rate = 0.0,
-                                 double total_weeks = 52.0) {
+template <typename Scalar, int Rows>
+double CalculateLifeYears(const BasicHistory<Scalar, Rows> &h,
+                          bool discount = false, double discount_rate = 0.0,
+                          double total_weeks = 52.0) {
     if (h.GetStateMap().empty()) {
         // log no state vector
         return 0.0;
@@ -80,7 +81,8 @@ inline double CalculateLifeYears(const History &h, bool discount = false,
     Eigen::VectorXd running_total = Eigen::VectorXd::Zero(history[0].size());
 
     for (int t = 0; t < history.size(); ++t) {
-        auto state = history[t];
+        // sum in double precision whatever the history was stored in
+        Eigen::VectorXd state = history[t].template cast<double>();
         running_total +=
             ((discount) ? Discount(state, discount_rate, t, true, total_weeks)
                         : state);
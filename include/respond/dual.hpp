@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: dual.hpp                                                             //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_DUAL_HPP_
+#define RESPOND_DUAL_HPP_
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+namespace respond {
+/// @brief A dual number carrying a value and its derivatives along N
+/// directions, for forward-mode differentiation of a model run.
+/// Used as the scalar of a CompiledModel, one run yields the trajectory and
+/// its derivatives with respect to the matrix entries the model was asked to
+/// differentiate by (see SensitivityEntry). Comparisons look at values only,
+/// so clamps and sparsity checks behave as they do for double.
+/// @tparam N The number of directions, i.e. parameters differentiated by.
+template <int N> class Dual {
+public:
+    static_assert(N > 0, "A dual number needs at least one direction");
+
+    /// @brief Number of derivative directions.
+    static constexpr int kDirections = N;
+
+    /// @brief Constructs a constant, i.e. a value with zero derivatives.
+    /// @param value The value.
+    Dual(double value = 0.0) : _value(value) { _derivatives.fill(0.0); }
+
+    /// @brief Constructs the variable of one direction, whose derivative
+    /// along that direction is 1.
+    /// @param value The value.
+    /// @param direction The direction the value is the variable of.
+    /// @return The seeded dual number.
+    static Dual Variable(double value, int direction) {
+        Dual ret(value);
+        ret._derivatives[direction] = 1.0;
+        return ret;
+    }
+
+    /// @brief Retrieves the value.
+    /// @return The value without derivatives.
+    double GetValue() const { return _value; }
+
+    /// @brief Retrieves the derivative along one direction.
+    /// @param direction The direction to read.
+    /// @return The derivative of the value along `direction`.
+    double GetDerivative(int direction) const {
+        return _derivatives[direction];
+    }
+
+    /// @brief Sets the derivative along one direction.
+    /// @param direction The direction to write.
+    /// @param derivative The new derivative.
+    void SetDerivative(int direction, double derivative) {
+        _derivatives[direction] = derivative;
+    }
+
+    /// @brief Indicates whether any derivative is non-zero.
+    /// @return True if the value depends on a direction.
+    bool HasDerivatives() const {
+        for (double d : _derivatives) {
+            if (d != 0.0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Drops the derivatives, e.g. when converting back to double.
+    explicit operator double() const { return _value; }
+
+    Dual operator-() const {
+        Dual ret(-_value);
+        for (int i = 0; i < N; ++i) {
+            ret._derivatives[i] = -_derivatives[i];
+        }
+        return ret;
+    }
+    Dual operator+() const { return *this; }
+
+    Dual &operator+=(const Dual &other) {
+        _value += other._value;
+        for (int i = 0; i < N; ++i) {
+            _derivatives[i] += other._derivatives[i];
+        }
+        return *this;
+    }
+    Dual &operator-=(const Dual &other) {
+        _value -= other._value;
+        for (int i = 0; i < N; ++i) {
+            _derivatives[i] -= other._derivatives[i];
+        }
+        return *this;
+    }
+    Dual &operator*=(const Dual &other) {
+        for (int i = 0; i < N; ++i) {
+            _derivatives[i] = _derivatives[i] * other._value +
+                              _value * other._derivatives[i];
+        }
+        _value *= other._value;
+        return *this;
+    }
+    Dual &operator/=(const Dual &other) {
+        const double inverse = 1.0 / other._value;
+        _value *= inverse;
+        for (int i = 0; i < N; ++i) {
+            _derivatives[i] =
+                (_derivatives[i] - _value * other._derivatives[i]) * inverse;
+        }
+        return *this;
+    }
+
+    friend Dual operator+(Dual a, const Dual &b) { return a += b; }
+    friend Dual operator-(Dual a, const Dual &b) { return a -= b; }
+    friend Dual operator*(Dual a, const Dual &b) { return a *= b; }
+    friend Dual operator/(Dual a, const Dual &b) { return a /= b; }
+
+    friend bool operator==(const Dual &a, const Dual &b) {
+        return a._value == b._value;
+    }
+    friend bool operator!=(const Dual &a, const Dual &b) {
+        return a._value != b._value;
+    }
+    friend bool operator<(const Dual &a, const Dual &b) {
+        return a._value < b._value;
+    }
+    friend bool operator>(const Dual &a, const Dual &b) {
+        return a._value > b._value;
+    }
+    friend bool operator<=(const Dual &a, const Dual &b) {
+        return a._value <= b._value;
+    }
+    friend bool operator>=(const Dual &a, const Dual &b) {
+        return a._value >= b._value;
+    }
+
+private:
+    double _value;
+    std::array<double, N> _derivatives;
+};
+
+// The functions Eigen calls on its scalars, found by argument-dependent
+// lookup.
+template <int N> Dual<N> abs(const Dual<N> &x) { return x < 0.0 ? -x : x; }
+template <int N> Dual<N> abs2(const Dual<N> &x) { return x * x; }
+template <int N> Dual<N> sqrt(const Dual<N> &x) {
+    const double root = std::sqrt(x.GetValue());
+    Dual<N> ret(root);
+    for (int i = 0; i < N; ++i) {
+        ret.SetDerivative(i, x.GetDerivative(i) / (2.0 * root));
+    }
+    return ret;
+}
+template <int N> const Dual<N> &conj(const Dual<N> &x) { return x; }
+template <int N> const Dual<N> &real(const Dual<N> &x) { return x; }
+template <int N> Dual<N> imag(const Dual<N> &) { return Dual<N>(0.0); }
+template <int N> bool isfinite(const Dual<N> &x) {
+    return std::isfinite(x.GetValue());
+}
+
+/// @brief Indicates whether a scalar type is a Dual.
+template <typename T> struct IsDual : std::false_type {};
+template <int N> struct IsDual<Dual<N>> : std::true_type {};
+
+/// @brief A transition matrix entry a model is differentiated by.
+/// Direction i of a dual-valued model is the entry at position i of the list
+/// given to CompiledModel::SetSensitivities().
+struct SensitivityEntry {
+    /// @brief Index of the transition in the model's chain.
+    std::size_t transition = 0;
+    /// @brief Index of the matrix in the transition, as ordered by
+    /// Transition::CopyTransitionMatrices().
+    std::size_t matrix = 0;
+    /// @brief Row of the entry.
+    Eigen::Index row = 0;
+    /// @brief Column of the entry; vector-valued matrices have only column 0.
+    Eigen::Index col = 0;
+};
+} // namespace respond
+
+namespace Eigen {
+/// @brief Lets Eigen hold respond::Dual in matrices. Precision constants are
+/// those of the value.
+template <int N>
+struct NumTraits<respond::Dual<N>> : NumTraits<double> {
+    using Real = respond::Dual<N>;
+    using NonInteger = respond::Dual<N>;
+    using Nested = respond::Dual<N>;
+    using Literal = double;
+    enum {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = N + 1,
+        AddCost = N + 1,
+        MulCost = 2 * N + 1
+    };
+};
+} // namespace Eigen
+
+#endif // RESPOND_DUAL_HPP_
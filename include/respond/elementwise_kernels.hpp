@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: elementwise_kernels.hpp                                              //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_ELEMENTWISE_KERNELS_HPP_
+#define RESPOND_ELEMENTWISE_KERNELS_HPP_
+
+#include <algorithm>
+#include <type_traits>
+
+#include <Eigen/Dense>
+
+#include <respond/history.hpp>
+
+namespace respond {
+// The arithmetic of the element-wise built-in transitions. Each kernel
+// updates a block of states in place and hands the outcomes it produces to
+// sinks, callables taking an Eigen array expression the size of the block.
+// The transitions, the typed pipeline, fused sweeps and the fast-forward
+// composition all run these kernels, each with its own sinks.
+
+/// @brief Removes fatal overdoses from a block of states.
+/// @param block The state elements, updated in place.
+/// @param overdose The overdose probabilities of the block's elements.
+/// @param fatality The probabilities that an overdose is fatal.
+/// @param total Sink receiving the block's overdoses.
+/// @param fatal Sink receiving the block's fatal overdoses.
+template <typename Block, typename OverdoseRate, typename FatalityRate,
+          typename TotalSink, typename FatalSink>
+void OverdoseKernel(Block &&block, const OverdoseRate &overdose,
+                    const FatalityRate &fatality, TotalSink &&total,
+                    FatalSink &&fatal) {
+    total(block * overdose);
+    fatal(block * overdose * fatality);
+    block -= block * overdose * fatality;
+}
+
+/// @brief Removes background deaths from a block of states.
+/// @param block The state elements, updated in place.
+/// @param rate The death probabilities of the block's elements.
+/// @param deaths Sink receiving the block's deaths.
+template <typename Block, typename DeathRate, typename DeathSink>
+void BackgroundDeathKernel(Block &&block, const DeathRate &rate,
+                           DeathSink &&deaths) {
+    deaths(block * rate);
+    block -= block * rate;
+}
+
+/// @brief Adds migrants to a block of states, clamping at zero so emigration
+/// never produces a negative population.
+/// @param block The state elements, updated in place.
+/// @param migrants The migrants of the block's elements.
+template <typename Block, typename Migrants>
+void MigrationKernel(Block &&block, const Migrants &migrants) {
+    using Scalar = typename std::decay_t<Block>::Scalar;
+    block = (block + migrants).max(Scalar(0));
+}
+
+/// @brief Sink adding outcomes to a history, or dropping them if the outcome
+/// is not recorded.
+/// @tparam HistoryType The history type, e.g. History.
+template <typename HistoryType> class HistorySink {
+public:
+    /// @brief Constructs the sink.
+    /// @param history The history to add to, or null.
+    explicit HistorySink(HistoryType *history) : _history(history) {}
+
+    template <typename Derived>
+    void operator()(const Eigen::ArrayBase<Derived> &outcome) const {
+        if (_history) {
+            _history->AccumulateState(outcome.matrix());
+        }
+    }
+
+private:
+    HistoryType *_history;
+};
+
+/// @brief Sink adding the outcomes of one block to a pending accumulator of
+/// state size, or dropping them if the outcome is not recorded.
+/// @tparam Scalar The scalar type of the accumulator.
+template <typename Scalar> class AccumulatorSink {
+public:
+    /// @brief Constructs the sink.
+    /// @param accumulator Start of the accumulator, or null.
+    /// @param start Index of the block's first element.
+    AccumulatorSink(Scalar *accumulator, Eigen::Index start)
+        : _target(accumulator ? accumulator + start : nullptr) {}
+
+    template <typename Derived>
+    void operator()(const Eigen::ArrayBase<Derived> &outcome) const {
+        if (_target) {
+            Eigen::Map<Eigen::Array<Scalar, Eigen::Dynamic, 1>>(
+                _target, outcome.size()) += outcome;
+        }
+    }
+
+private:
+    Scalar *_target;
+};
+
+/// @brief Destinations for the outcome contributions of a blocked sweep.
+/// Each pointer addresses the start of a pending accumulator of state size,
+/// or is null when the outcome is not recorded.
+/// @tparam Scalar The scalar type of the accumulators.
+template <typename Scalar> struct BlockOutcomes {
+    Scalar *total_overdose = nullptr;
+    Scalar *fatal_overdose = nullptr;
+    Scalar *background_death = nullptr;
+};
+
+/// @brief Resolves the element-wise outcome channels to their pending
+/// accumulators.
+/// @param slots The channel slots of the model's histories.
+/// @param size The state size.
+/// @param outcomes Receives the accumulators.
+/// @return False if a recorded outcome is not an accumulated history, since
+/// those cannot be written block by block.
+template <typename Slots, typename Scalar>
+bool ResolveBlockOutcomes(const Slots &slots, Eigen::Index size,
+                          BlockOutcomes<Scalar> &outcomes) {
+    auto resolve = [&](HistoryChannel channel, Scalar *&target) {
+        auto *history = slots[channel];
+        target = nullptr;
+        if (!history) {
+            return true;
+        }
+        if (history->GetHistoryMode() != HistoryMode::Accumulated) {
+            return false;
+        }
+        target = history->GetPendingAccumulator(size).data();
+        return true;
+    };
+    return resolve(HistoryChannel::kTotalOverdose, outcomes.total_overdose) &&
+           resolve(HistoryChannel::kFatalOverdose, outcomes.fatal_overdose) &&
+           resolve(HistoryChannel::kBackgroundDeath,
+                   outcomes.background_death);
+}
+
+/// @brief Passes a state through a run of element-wise stages block by
+/// block, so each block is read once, stays cache resident through every
+/// stage and is written once.
+/// @tparam Scalar The scalar type of the state.
+/// @tparam BlockSize Number of state elements processed per block.
+/// @param in The state. Must not alias `out`.
+/// @param out Receives the resulting state.
+/// @param apply Called as apply(start, block) for each block, where `block`
+/// holds the state elements [start, start + block.size()).
+template <typename Scalar, Eigen::Index BlockSize, typename In, typename Out,
+          typename ApplyStages>
+void SweepBlocks(const In &in, Out &out, ApplyStages &&apply) {
+    const Eigen::Index size = in.size();
+    out.resize(size);
+    // fixed capacity keeps the block on the stack and in cache
+    Eigen::Array<Scalar, Eigen::Dynamic, 1, 0, BlockSize, 1> block;
+    for (Eigen::Index start = 0; start < size; start += BlockSize) {
+        const Eigen::Index length = std::min(BlockSize, size - start);
+        block = in.segment(start, length).array();
+        apply(start, block);
+        out.segment(start, length) = block.matrix();
+    }
+}
+} // namespace respond
+
+#endif // RESPOND_ELEMENTWISE_KERNELS_HPP_
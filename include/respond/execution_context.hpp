@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: execution_context.hpp                                                //
+// Project: respond                                                           //
+// Created Date: 2026-10-16                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_EXECUTION_CONTEXT_HPP_
+#define RESPOND_EXECUTION_CONTEXT_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <respond/history.hpp>
+#include <respond/random.hpp>
+
+namespace respond {
+/// @brief Per-step data a Model hands to each Transition it executes.
+/// The context is built once per call to RunTransitions() and shared by every
+/// transition in the chain, so transitions should treat it as borrowed.
+/// Transitions may add histories but must not erase them.
+struct ExecutionContext {
+    /// @brief Constructs a context around the model's history records,
+    /// resolving the channel slots.
+    /// @param h The history records transitions may write outcomes to.
+    explicit ExecutionContext(std::map<std::string, History> &h)
+        : histories(h), slots(h) {}
+
+    /// @brief Constructs a context around history records whose channel
+    /// slots the model has already resolved.
+    /// @param h The history records transitions may write outcomes to.
+    /// @param s The channel slots of `h`.
+    /// @param t The timestep being executed.
+    ExecutionContext(std::map<std::string, History> &h, const HistorySlots &s,
+                     int t = 0)
+        : histories(h), slots(s), timestep(t) {}
+
+    /// @brief The history records owned by the executing model.
+    std::map<std::string, History> &histories;
+    /// @brief The channel histories of `histories`; built-in transitions
+    /// record their outcomes through these instead of by name.
+    HistorySlots slots;
+    /// @brief The timestep being executed, i.e. the one the step starts from.
+    int timestep = 0;
+    /// @brief The key of a stochastic run, or nullptr for the expected-value
+    /// run. Built-in transitions draw their moves from its streams.
+    const RandomKey *random = nullptr;
+    /// @brief The position of the executing transition in the chain, which
+    /// names its random streams.
+    int transition = 0;
+};
+
+/// @brief Per-step data a Model hands to each Transition when it executes a
+/// batch of scenarios stored as the columns of a state matrix.
+struct BatchExecutionContext {
+    /// @brief Constructs a context around the per-column history records,
+    /// resolving the channel slots.
+    /// @param h One set of history records per state column.
+    explicit BatchExecutionContext(
+        std::vector<std::map<std::string, History>> &h)
+        : histories(h), _resolved(h.begin(), h.end()), slots(_resolved) {}
+
+    /// @brief Constructs a context around per-column history records whose
+    /// channel slots the model has already resolved. The slots are borrowed,
+    /// not copied, so a batched step does not allocate.
+    /// @param h One set of history records per state column.
+    /// @param s The channel slots of each entry of `h`; must outlive the
+    /// context.
+    /// @param t The timestep being executed.
+    BatchExecutionContext(std::vector<std::map<std::string, History>> &h,
+                          const std::vector<HistorySlots> &s, int t = 0)
+        : histories(h), slots(s), timestep(t) {}
+
+    /// @brief Deleted copy constructor; `slots` may refer into the context.
+    BatchExecutionContext(const BatchExecutionContext &) = delete;
+    /// @brief Deleted copy assignment operator.
+    BatchExecutionContext &operator=(const BatchExecutionContext &) = delete;
+
+    /// @brief The history records of each scenario, indexed by state column.
+    std::vector<std::map<std::string, History>> &histories;
+
+private:
+    // slots resolved by the context itself when the caller has none
+    std::vector<HistorySlots> _resolved;
+
+public:
+    /// @brief The channel histories of each scenario, indexed by state column.
+    const std::vector<HistorySlots> &slots;
+    /// @brief The timestep being executed, shared by every scenario.
+    int timestep = 0;
+    /// @brief The key of a stochastic run, or nullptr for the expected-value
+    /// run. Every scenario draws from the same streams.
+    const RandomKey *random = nullptr;
+    /// @brief The position of the executing transition in the chain.
+    int transition = 0;
+};
+} // namespace respond
+
+#endif // RESPOND_EXECUTION_CONTEXT_HPP_
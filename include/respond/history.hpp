@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -13,7 +13,10 @@
 #define RESPOND_HISTORY_HPP_
 
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <map>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -30,45 +33,112 @@ inline HistoryMode GetDefaultHistoryMode(const std::string &name) {
     return HistoryMode::Snapshot;
 }
 
+/// @brief The histories models and built-in transitions record to.
+enum class HistoryChannel : int {
+    kState = 0,
+    kTotalOverdose = 1,
+    kFatalOverdose = 2,
+    kInterventionAdmission = 3,
+    kBackgroundDeath = 4
+};
+
+/// @brief Number of HistoryChannel values.
+inline constexpr int kHistoryChannelCount = 5;
+
+/// @brief A set of history channels, indexed by HistoryChannel value.
+using HistoryChannelSet = std::bitset<kHistoryChannelCount>;
+
+/// @brief Retrieves the set of every history channel.
+/// @return A set with all channels included.
+inline HistoryChannelSet AllHistoryChannels() {
+    return HistoryChannelSet().set();
+}
+
+/// @brief Retrieves the history name a channel is recorded under.
+/// @param channel The channel to name.
+/// @return The key of the channel's history in a model's history map.
+inline const char *GetHistoryChannelName(HistoryChannel channel) {
+    switch (channel) {
+    case HistoryChannel::kState:
+        return "state";
+    case HistoryChannel::kTotalOverdose:
+        return "total_overdose";
+    case HistoryChannel::kFatalOverdose:
+        return "fatal_overdose";
+    case HistoryChannel::kInterventionAdmission:
+        return "intervention_admission";
+    case HistoryChannel::kBackgroundDeath:
+        return "background_death";
+    }
+    return "";
+}
+
 /// @brief Tracks and manages state vector history over time.
 /// History records state snapshots at discrete timesteps, enabling analysis of
 /// state trajectories during model execution. Supports sparse timesteps (gaps
-/// are filled with zero vectors).
-class History {
+/// are filled with zero vectors). The scalar type selects the precision the
+/// recorded states are stored in and Rows optionally fixes their dimension at
+/// compile time; History records dynamically sized double precision states.
+template <typename Scalar, int Rows = Eigen::Dynamic> class BasicHistory {
 public:
+    /// @brief The vector type states are recorded as.
+    using Vector = Eigen::Matrix<Scalar, Rows, 1>;
+
     /// @brief Constructs a History tracker.
     /// @param name The identifier for this history (default: "state").
     /// @param log_name The logger name for error reporting (default:
     /// "console").
-    History(const std::string &name = "state",
-            const std::string &log_name = "console")
-        : History(name, log_name, GetDefaultHistoryMode(name)) {}
+    BasicHistory(const std::string &name = "state",
+                 const std::string &log_name = "console")
+        : BasicHistory(name, log_name, GetDefaultHistoryMode(name)) {}
 
     /// @brief Constructs a History tracker with an explicit recording mode.
     /// @param name The identifier for this history.
     /// @param log_name The logger name for error reporting.
     /// @param mode Whether the history stores snapshots or accumulations.
-    History(const std::string &name, const std::string &log_name,
-            HistoryMode mode)
-        : _log_name(log_name), _name(name), _mode(mode) {}
+    BasicHistory(const std::string &name, const std::string &log_name,
+                 HistoryMode mode)
+        : _log_name(log_name), _name(name), _mode(mode) {
+        ResetPendingState();
+    }
+
+    /// @brief Converts a history recorded at another precision or size.
+    /// Converting to a fixed size requires every state to have that size.
+    /// @param other The history to copy and cast.
+    template <typename OtherScalar, int OtherRows>
+    explicit BasicHistory(const BasicHistory<OtherScalar, OtherRows> &other)
+        : _log_name(other.GetLogName()), _name(other.GetHistoryName()),
+          _mode(other.GetHistoryMode()),
+          _timesteps(other.GetRecordedTimesteps()) {
+        _states.reserve(other.GetRecordedStates().size());
+        for (const auto &s : other.GetRecordedStates()) {
+            _states.push_back(s.template cast<Scalar>());
+        }
+        ResetPendingState();
+        if (other.HasPendingState()) {
+            _pending_state = other.GetPendingState().template cast<Scalar>();
+            _has_pending_state = true;
+        }
+    }
 
     /// @brief Destructor (default).
-    ~History() = default;
+    ~BasicHistory() = default;
     /// @brief Copy constructor implementing the Rule of Five.
     /// Creates an independent copy of the history state and metadata.
-    History(const History &other) {
+    BasicHistory(const BasicHistory &other) {
         _timesteps = other.GetRecordedTimesteps();
         _states = other.GetRecordedStates();
         _name = other.GetHistoryName();
         _log_name = other.GetLogName();
         _mode = other.GetHistoryMode();
         _pending_state = other.GetPendingState();
+        _has_pending_state = other.HasPendingState();
     }
 
     /// @brief Copy assignment operator implementing the Rule of Five.
     /// @param other The history to copy from.
     /// @return Reference to this history after assignment.
-    History &operator=(const History &other) {
+    BasicHistory &operator=(const BasicHistory &other) {
         if (this != &other) {
             _timesteps = other.GetRecordedTimesteps();
             _states = other.GetRecordedStates();
@@ -76,6 +146,7 @@ public:
             _log_name = other.GetLogName();
             _mode = other.GetHistoryMode();
             _pending_state = other.GetPendingState();
+            _has_pending_state = other.HasPendingState();
         }
         return *this;
     }
@@ -83,19 +154,21 @@ public:
     /// @brief Move constructor implementing the Rule of Five.
     /// @param other The history to move from (leaves original state unchanged
     /// per current implementation).
-    History(History &&other) noexcept {
+    BasicHistory(BasicHistory &&other) noexcept {
         _timesteps = std::move(other._timesteps);
         _states = std::move(other._states);
         _name = other.GetHistoryName();
         _log_name = other.GetLogName();
         _mode = other.GetHistoryMode();
         _pending_state = std::move(other._pending_state);
+        _has_pending_state = other._has_pending_state;
+        other.ResetPendingState();
     }
 
     /// @brief Move assignment operator implementing the Rule of Five.
     /// @param other The history to move from.
     /// @return Reference to this history after assignment.
-    History &operator=(History &&other) noexcept {
+    BasicHistory &operator=(BasicHistory &&other) noexcept {
         if (this != &other) {
             _timesteps = std::move(other._timesteps);
             _states = std::move(other._states);
@@ -103,6 +176,8 @@ public:
             _log_name = other.GetLogName();
             _mode = other.GetHistoryMode();
             _pending_state = std::move(other._pending_state);
+            _has_pending_state = other._has_pending_state;
+            other.ResetPendingState();
         }
         return *this;
     }
@@ -110,23 +185,27 @@ public:
     /// @brief Equality comparison operator.
     /// @param other The history to compare with.
     /// @return True if all history properties and state are identical.
-    bool operator==(const History &other) const {
+    bool operator==(const BasicHistory &other) const {
         return GetHistoryName() == other.GetHistoryName() &&
                GetLogName() == other.GetLogName() &&
                GetHistoryMode() == other.GetHistoryMode() &&
                GetStateMap() == other.GetStateMap() &&
-               GetPendingState().isApprox(other.GetPendingState());
+               HasPendingState() == other.HasPendingState() &&
+               (!HasPendingState() ||
+                GetPendingState().isApprox(other.GetPendingState()));
     }
 
     /// @brief Inequality comparison operator.
     /// @param other The history to compare with.
     /// @return True if histories differ in any aspect.
-    bool operator!=(const History &other) const { return !(*this == other); }
+    bool operator!=(const BasicHistory &other) const {
+        return !(*this == other);
+    }
 
     /// @brief Retrieves the complete state map (timestep -> state vector).
     /// @return Map of integer timesteps to Eigen vectors representing states.
-    std::map<int, Eigen::VectorXd> GetStateMap() const {
-        std::map<int, Eigen::VectorXd> state_map;
+    std::map<int, Vector> GetStateMap() const {
+        std::map<int, Vector> state_map;
         for (size_t index = 0; index < _timesteps.size(); ++index) {
             state_map[_timesteps[index]] = _states[index];
         }
@@ -139,7 +218,7 @@ public:
 
     /// @brief Retrieves the recorded state vectors without densifying gaps.
     /// @return Const reference to the stored state vectors.
-    const std::vector<Eigen::VectorXd> &GetRecordedStates() const {
+    const std::vector<Vector> &GetRecordedStates() const {
         return _states;
     }
 
@@ -149,11 +228,21 @@ public:
 
     /// @brief Indicates whether an accumulated history has pending state.
     /// @return True when a pending aggregate exists.
-    bool HasPendingState() const { return _pending_state.size() > 0; }
+    bool HasPendingState() const { return _has_pending_state; }
 
     /// @brief Retrieves the pending accumulated state.
-    /// @return The pending aggregate vector, or an empty vector if none.
-    Eigen::VectorXd GetPendingState() const { return _pending_state; }
+    /// @return The pending aggregate vector, or an empty (zero for fixed size
+    /// histories) vector if none.
+    Vector GetPendingState() const {
+        if (_has_pending_state) {
+            return _pending_state;
+        }
+        if constexpr (Rows == Eigen::Dynamic) {
+            return Vector();
+        } else {
+            return Vector::Zero();
+        }
+    }
 
     /// @brief Retrieves the latest recorded timestep.
     /// @return Largest recorded timestep, or -1 if history is empty.
@@ -176,8 +265,8 @@ public:
     /// Gaps in timesteps are filled with zero vectors of appropriate dimension.
     /// @return Vector of Eigen vectors from timestep 0 to the maximum recorded
     /// timestep. Returns empty vector if no state has been recorded.
-    std::vector<Eigen::VectorXd> GetStateAsVector() const {
-        std::vector<Eigen::VectorXd> ret;
+    std::vector<Vector> GetStateAsVector() const {
+        std::vector<Vector> ret;
         if (_states.empty()) {
             // warn empty state vector - no states recorded
             return {};
@@ -206,7 +295,7 @@ public:
     /// automatic next timestep). If timestep is negative, the next sequential
     /// timestep is used automatically. If timestep already exists, it is
     /// considered invalid but is currently overwritten.
-    void AddState(const Eigen::Ref<const Eigen::VectorXd> &state,
+    void AddState(const Eigen::Ref<const Vector> &state,
                   int timestep = -1) {
         if (timestep < 0) {
             timestep = GetNextTimestep();
@@ -228,26 +317,56 @@ public:
     /// @brief Records a snapshot value at a concrete timestep.
     /// @param state The snapshot value to record.
     /// @param timestep The simulation timestep for this snapshot.
-    void RecordSnapshot(const Eigen::Ref<const Eigen::VectorXd> &state,
+    void RecordSnapshot(const Eigen::Ref<const Vector> &state,
                         int timestep) {
         AddState(state, timestep);
     }
 
     /// @brief Adds a contribution to an accumulated history.
+    /// Accepts any Eigen vector expression, so derived outcomes are summed
+    /// straight into the pending aggregate without a temporary vector.
     /// @param state The per-step contribution to accumulate.
-    void AccumulateState(const Eigen::Ref<const Eigen::VectorXd> &state) {
+    template <typename Derived>
+    void AccumulateState(const Eigen::MatrixBase<Derived> &state) {
         if (_mode != HistoryMode::Accumulated) {
             AddState(state);
             return;
         }
 
-        if (_pending_state.size() == 0) {
+        if (!_has_pending_state) {
             _pending_state = state;
+            _has_pending_state = true;
             return;
         }
         _pending_state += state;
     }
 
+    /// @brief Exposes the pending aggregate for in-place accumulation, e.g. by
+    /// kernels that add contributions one segment at a time.
+    /// The aggregate is zero-initialized if nothing is pending yet.
+    /// @param size The dimension of the aggregate.
+    /// @return Mutable reference to the pending aggregate.
+    Vector &GetPendingAccumulator(Eigen::Index size) {
+        if (!_has_pending_state || _pending_state.size() != size) {
+            _pending_state.setZero(size);
+            _has_pending_state = true;
+        }
+        return _pending_state;
+    }
+
+    /// @brief Allocates storage ahead of a run so recording does not grow
+    /// containers or reallocate the pending aggregate mid-run. A model
+    /// reserves its histories when it is finalized.
+    /// @param records The number of records still to come.
+    /// @param size The dimension of the recorded states.
+    void Reserve(std::size_t records, Eigen::Index size) {
+        _timesteps.reserve(_timesteps.size() + records);
+        _states.reserve(_states.size() + records);
+        if (_mode == HistoryMode::Accumulated && !_has_pending_state) {
+            _pending_state.resize(size);
+        }
+    }
+
     /// @brief Flushes pending accumulated state into a recorded timestep.
     /// @param timestep The simulation timestep to record.
     /// @param state_size Size of a zero vector to record if nothing is pending.
@@ -256,22 +375,56 @@ public:
             return;
         }
 
-        Eigen::VectorXd value;
-        if (_pending_state.size() > 0) {
-            value = _pending_state;
+        // the aggregate is copied straight into its record and its buffer
+        // kept, so a flush allocates only the stored record itself
+        Vector &record = GetRecord(timestep);
+        if (_has_pending_state) {
+            record = _pending_state;
         } else {
-            value = Eigen::VectorXd::Zero(state_size);
+            record.setZero(state_size);
         }
+        ResetPendingState();
+    }
 
-        AddState(value, timestep);
-        _pending_state.resize(0);
+    /// @brief Copies the history without its records, keeping the name, mode
+    /// and pending aggregate, to continue recording where this one stops.
+    /// @return A history that has recorded nothing yet.
+    BasicHistory WithoutRecords() const {
+        BasicHistory ret(_name, _log_name, _mode);
+        if (_has_pending_state) {
+            ret._pending_state = _pending_state;
+            ret._has_pending_state = true;
+        }
+        return ret;
+    }
+
+    /// @brief Appends the records of a history continuing this one and takes
+    /// over its pending aggregate.
+    /// Records at timesteps this history already holds are overwritten.
+    /// @param later The history recorded after this one.
+    void AppendRecords(const BasicHistory &later) {
+        _timesteps.reserve(_timesteps.size() + later._timesteps.size());
+        _states.reserve(_states.size() + later._states.size());
+        for (size_t index = 0; index < later._timesteps.size(); ++index) {
+            const int timestep = later._timesteps[index];
+            if (timestep > GetLatestRecordedTimestep()) {
+                _timesteps.push_back(timestep);
+                _states.push_back(later._states[index]);
+            } else {
+                GetRecord(timestep) = later._states[index];
+            }
+        }
+        _has_pending_state = later._has_pending_state;
+        if (_has_pending_state) {
+            _pending_state = later._pending_state;
+        }
     }
 
     /// @brief Clears all recorded state history.
     void Clear() {
         _timesteps.clear();
         _states.clear();
-        _pending_state.resize(0);
+        ResetPendingState();
     }
 
 private:
@@ -284,9 +437,31 @@ private:
     /// @brief Recorded timestep indices for sparse history capture.
     std::vector<int> _timesteps;
     /// @brief Recorded state vectors aligned with _timesteps.
-    std::vector<Eigen::VectorXd> _states;
+    std::vector<Vector> _states;
     /// @brief Pending aggregate for accumulated histories.
-    Eigen::VectorXd _pending_state;
+    Vector _pending_state;
+    /// @brief Whether _pending_state holds an aggregate. Fixed size vectors
+    /// cannot be emptied, so emptiness is tracked separately.
+    bool _has_pending_state = false;
+
+    /// @brief Drops the pending aggregate. The buffer is kept for the next
+    /// accumulation, which assigns rather than adds to it.
+    void ResetPendingState() { _has_pending_state = false; }
+
+    /// @brief Finds the record at a timestep, appending an empty one if
+    /// there is none.
+    /// @param timestep The timestep of the record.
+    /// @return Mutable reference to the recorded state.
+    Vector &GetRecord(int timestep) {
+        const auto existing =
+            std::find(_timesteps.begin(), _timesteps.end(), timestep);
+        if (existing != _timesteps.end()) {
+            return _states[static_cast<size_t>(existing - _timesteps.begin())];
+        }
+        _timesteps.push_back(timestep);
+        _states.emplace_back();
+        return _states.back();
+    }
 
     /// @brief Computes the next sequential timestep.
     /// @return 0 if history is empty, otherwise one past the largest existing
@@ -301,10 +476,95 @@ private:
     /// @brief Creates a zero vector of specified size.
     /// @param size The dimensionality of the zero vector.
     /// @return An Eigen vector of zeros with the specified size.
-    Eigen::VectorXd GetZeroVector(const int &size) const {
-        return Eigen::VectorXd::Zero(size);
+    Vector GetZeroVector(const int &size) const {
+        return Vector::Zero(size);
     }
 };
+
+/// @brief History recorded in double precision, used by the Model interface.
+using History = BasicHistory<double>;
+
+/// @brief The histories of a history map's channels, resolved by name once so
+/// the hot loop indexes an array instead of searching the map.
+/// Entries of a std::map keep their address, so the slots stay valid until a
+/// resolved history is erased or the map is assigned to.
+template <typename Scalar, int Rows = Eigen::Dynamic> class BasicHistorySlots {
+public:
+    using HistoryType = BasicHistory<Scalar, Rows>;
+    using HistoryMap = std::map<std::string, HistoryType>;
+
+    /// @brief Constructs slots with no channel recorded.
+    BasicHistorySlots() { _slots.fill(nullptr); }
+
+    /// @brief Constructs slots resolved against a history map.
+    /// @param histories The history map to resolve.
+    /// @param channels The channels to resolve; the others stay empty.
+    explicit BasicHistorySlots(
+        HistoryMap &histories,
+        const HistoryChannelSet &channels = AllHistoryChannels()) {
+        Resolve(histories, channels);
+    }
+
+    /// @brief Points each channel at its history, or at nothing if the map
+    /// does not record it or the channel is not in the given set.
+    /// @param histories The history map to resolve.
+    /// @param channels The channels to resolve; the others are left empty.
+    void Resolve(HistoryMap &histories,
+                 const HistoryChannelSet &channels = AllHistoryChannels()) {
+        for (int c = 0; c < kHistoryChannelCount; ++c) {
+            _slots[c] = nullptr;
+            if (!channels[c]) {
+                continue;
+            }
+            auto found = histories.find(
+                GetHistoryChannelName(static_cast<HistoryChannel>(c)));
+            if (found != histories.end()) {
+                _slots[c] = &found->second;
+            }
+        }
+    }
+
+    /// @brief Points each channel at its history, default-constructing the
+    /// histories of the given channels that the map does not hold yet.
+    /// @param histories The history map to resolve and extend.
+    /// @param channels The channels to create histories for.
+    void ResolveOrCreate(HistoryMap &histories,
+                         const HistoryChannelSet &channels =
+                             AllHistoryChannels()) {
+        Resolve(histories, channels);
+        for (int c = 0; c < kHistoryChannelCount; ++c) {
+            if (channels[c] && !_slots[c]) {
+                const auto channel = static_cast<HistoryChannel>(c);
+                _slots[c] = &histories[GetHistoryChannelName(channel)];
+            }
+        }
+    }
+
+    /// @brief Indicates whether every channel of a set has a history.
+    /// @param channels The channels to check.
+    /// @return True if no slot of the set is empty.
+    bool IsComplete(const HistoryChannelSet &channels =
+                        AllHistoryChannels()) const {
+        for (int c = 0; c < kHistoryChannelCount; ++c) {
+            if (channels[c] && !_slots[c]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Retrieves the history of a channel.
+    /// @param channel The channel to look up.
+    /// @return The channel's history, or nullptr if it is not recorded.
+    HistoryType *operator[](HistoryChannel channel) const {
+        return _slots[static_cast<int>(channel)];
+    }
+
+private:
+    std::array<HistoryType *, kHistoryChannelCount> _slots;
+};
+
+using HistorySlots = BasicHistorySlots<double>;
 } // namespace respond
 
 #endif // RESPOND_HISTORY_HPP_
\ No newline at end of file
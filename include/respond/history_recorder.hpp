@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: history_recorder.hpp                                                 //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_HISTORY_RECORDER_HPP_
+#define RESPOND_HISTORY_RECORDER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <respond/history.hpp>
+
+namespace respond {
+/// @brief The history bookkeeping shared by the model implementations: which
+/// channels are kept, at which timesteps records are taken and how a record
+/// is made from the state and the pending outcomes.
+/// The recorder holds no histories itself; the model passes its history map
+/// and channel slots, at whatever precision it stores them.
+class HistoryRecorder {
+public:
+    /// @brief Creates the default histories: the state snapshot, total and
+    /// fatal overdoses, intervention admissions and background mortality.
+    /// @param log_name Name of the logger the histories write errors to.
+    /// @return The default history objects by name.
+    static std::map<std::string, History>
+    DefaultHistories(const std::string &log_name) {
+        std::map<std::string, History> ret;
+        ret["state"] = History("state", log_name, HistoryMode::Snapshot);
+        for (const auto &name :
+             {"total_overdose", "fatal_overdose", "intervention_admission",
+              "background_death"}) {
+            ret[name] = History(name, log_name, HistoryMode::Accumulated);
+        }
+        return ret;
+    }
+
+    /// @brief Restricts the kept histories to a set of channels.
+    /// @param channels The channels to keep.
+    void SetSubscribedChannels(const std::vector<HistoryChannel> &channels) {
+        _subscribed.reset();
+        for (auto channel : channels) {
+            _subscribed.set(static_cast<int>(channel));
+        }
+    }
+
+    /// @brief Retrieves the kept channels.
+    /// @return The channels in enumeration order.
+    std::vector<HistoryChannel> GetSubscribedChannels() const {
+        std::vector<HistoryChannel> channels;
+        for (int c = 0; c < kHistoryChannelCount; ++c) {
+            if (_subscribed[c]) {
+                channels.push_back(static_cast<HistoryChannel>(c));
+            }
+        }
+        return channels;
+    }
+
+    /// @brief Retrieves the kept channels as the set slots resolve against.
+    /// @return The subscribed channel set.
+    const HistoryChannelSet &GetSubscribed() const { return _subscribed; }
+
+    /// @brief Sets how many timesteps apart records are taken; values below
+    /// 1 record every timestep.
+    /// @param interval The capture interval.
+    void SetCaptureInterval(int interval) {
+        _capture_interval = (interval < 1) ? 1 : interval;
+    }
+    int GetCaptureInterval() const { return _capture_interval; }
+
+    /// @brief Sets a timestep that is always recorded, or -1 for none.
+    /// @param final_timestep The final timestep of the run.
+    void SetFinalTimestep(int final_timestep) {
+        _final_timestep = final_timestep;
+    }
+    int GetFinalTimestep() const { return _final_timestep; }
+
+    /// @brief Indicates whether a record is taken at a timestep.
+    /// @param timestep The timestep.
+    /// @return True for timestep 0, the final timestep and every multiple of
+    /// the capture interval.
+    bool ShouldRecord(int timestep) const {
+        if (timestep == 0) {
+            return true;
+        }
+        if (_final_timestep >= 0 && timestep == _final_timestep) {
+            return true;
+        }
+        return timestep % _capture_interval == 0;
+    }
+
+    /// @brief Finds the first timestep after a given one that is recorded.
+    /// @param timestep The timestep.
+    /// @return The next recorded timestep.
+    int NextRecordTimestep(int timestep) const {
+        int next = (timestep / _capture_interval + 1) * _capture_interval;
+        if (_final_timestep > timestep) {
+            next = std::min(next, _final_timestep);
+        }
+        return next;
+    }
+
+    /// @brief Counts the records a run from a timestep to the final timestep
+    /// takes, for reserving history storage up front.
+    /// @param timestep The timestep the run starts from.
+    /// @return The number of records, at least 1.
+    std::size_t RecordsFrom(int timestep) const {
+        std::size_t records = 1;
+        if (_final_timestep > timestep) {
+            records += static_cast<std::size_t>((_final_timestep - timestep) /
+                                                _capture_interval);
+        }
+        return records;
+    }
+
+    /// @brief Erases the histories of unsubscribed channels from a map.
+    /// @param histories The history map.
+    template <typename HistoryMap>
+    void DropUnsubscribed(HistoryMap &histories) const {
+        for (int c = 0; c < kHistoryChannelCount; ++c) {
+            if (!_subscribed[c]) {
+                histories.erase(
+                    GetHistoryChannelName(static_cast<HistoryChannel>(c)));
+            }
+        }
+    }
+
+    /// @brief Finds the latest timestep recorded in any history of a map.
+    /// @param histories The history map.
+    /// @return The timestep, or -1 if nothing is recorded.
+    template <typename HistoryMap>
+    static int LatestRecordedTimestep(const HistoryMap &histories) {
+        int latest = -1;
+        for (const auto &kv : histories) {
+            latest = std::max(latest, kv.second.GetLatestRecordedTimestep());
+        }
+        return latest;
+    }
+
+    /// @brief Takes one record: snapshots the state and flushes the pending
+    /// outcomes. Recording creates any subscribed channel history the map
+    /// is missing, so after the first record every slot is filled and no
+    /// names are looked up.
+    /// @param histories The history map of the model.
+    /// @param slots The channel slots of `histories`.
+    /// @param state The state at `timestep`.
+    /// @param timestep The timestep recorded.
+    /// @return True if histories were added to the map.
+    template <typename HistoryMap, typename Slots, typename State>
+    bool Record(HistoryMap &histories, Slots &slots, const State &state,
+                int timestep) const {
+        const bool create = !slots.IsComplete(_subscribed);
+        if (create) {
+            slots.ResolveOrCreate(histories, _subscribed);
+        }
+        if (auto *snapshot = slots[HistoryChannel::kState]) {
+            snapshot->RecordSnapshot(state, timestep);
+        }
+        const auto size = state.size();
+        for (auto channel : {HistoryChannel::kInterventionAdmission,
+                             HistoryChannel::kTotalOverdose,
+                             HistoryChannel::kFatalOverdose,
+                             HistoryChannel::kBackgroundDeath}) {
+            if (auto *outcome = slots[channel]) {
+                outcome->FlushPendingState(timestep, size);
+            }
+        }
+        return create;
+    }
+
+private:
+    HistoryChannelSet _subscribed = AllHistoryChannels();
+    int _capture_interval = 1;
+    int _final_timestep = -1;
+};
+} // namespace respond
+
+#endif // RESPOND_HISTORY_RECORDER_HPP_
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -12,16 +12,53 @@
 #ifndef RESPOND_MODEL_HPP_
 #define RESPOND_MODEL_HPP_
 
+#include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include <Eigen/Dense>
 
 #include <respond/history.hpp>
+#include <respond/logging.hpp>
+#include <respond/random.hpp>
 #include <respond/transition.hpp>
 
 namespace respond {
+/// @brief Floating point precision a model stores its state and histories in.
+enum class Precision : int {
+    kDouble = 0, // 64-bit, the reference implementation
+    kSingle = 1  // 32-bit, halves the memory traffic of large ensembles
+};
+
+/// @brief How a model advances its state.
+enum class ExecutionMode : int {
+    kExpectedValue = 0, // the expected state of the population, the default
+    kStochastic = 1     // one random realization of a whole-number population
+};
+
+/// @brief The state of a model some number of steps ahead of its current
+/// timestep, together with the outcomes of the steps in between.
+struct Projection {
+    /// @brief The projected state.
+    Eigen::VectorXd state;
+    /// @brief The outcomes of every projected step summed per outcome
+    /// history, keyed by history name like Model::GetHistories().
+    std::map<std::string, Eigen::VectorXd> outcomes;
+};
+
+/// @brief The outcome of running a model until its state stops changing.
+struct Convergence {
+    /// @brief True if the change fell to the tolerance within the step limit.
+    bool converged = false;
+    /// @brief The number of timesteps executed.
+    int steps = 0;
+    /// @brief The relative change of the last step, see
+    /// Model::RunUntilConverged().
+    double change = 0.0;
+};
+
 /// @brief Abstract base class representing a state transition model.
 /// Models manage a state vector, execute transitions, and maintain history of
 /// state changes. Subclasses must implement state management, transition
@@ -39,16 +76,194 @@ public:
     /// @return A copy of the current state vector (limited to observation).
     virtual Eigen::VectorXd GetState() const = 0;
 
+    /// @brief Switches the model to batched execution of several scenarios.
+    /// Each column of `states` is an independent state vector; transitions
+    /// are then applied to all columns at once so matrix transitions become a
+    /// single matrix-matrix product. Every column records its own histories,
+    /// starting from a copy of the model's current histories. Calling
+    /// SetState() returns the model to single-scenario execution.
+    /// @param states The scenario states, one per column. A copy is made.
+    virtual void
+    SetBatchState(const Eigen::Ref<const Eigen::MatrixXd> &states) = 0;
+
+    /// @brief Retrieves the current scenario states of a batched model.
+    /// @return A copy of the state matrix, empty if the model is not batched.
+    virtual Eigen::MatrixXd GetBatchState() const = 0;
+
+    /// @brief Indicates whether the model is executing a batch of scenarios.
+    /// @return True if SetBatchState() was called with at least one column.
+    virtual bool IsBatched() const = 0;
+
+    /// @brief Retrieves the history records of each scenario in a batch.
+    /// @return One map of history names to History objects per state column.
+    virtual std::vector<std::map<std::string, History>>
+    GetBatchHistories() const = 0;
+
     /// @brief Executes all registered transitions on the current state.
     /// Transitions are applied in the order they were added and may modify
     /// history.
     virtual void RunTransitions() = 0;
 
+    /// @brief Executes the transitions for a number of timesteps.
+    /// Histories are recorded at the same timesteps, and with the same
+    /// values up to rounding, as calling RunTransitions() `steps` times, which
+    /// is what the default implementation does.
+    /// @param steps The number of timesteps to advance.
+    virtual void RunFor(int steps) {
+        for (int i = 0; i < steps; ++i) {
+            RunTransitions();
+        }
+    }
+
+    /// @brief Executes timesteps until the state stops changing.
+    /// After each step the change is measured as the largest absolute change
+    /// of an element relative to the largest element before the step (the
+    /// absolute change if the state was zero). A batched model converges once
+    /// all of its scenarios do. Histories are recorded as by
+    /// RunTransitions(); the converged state itself is only recorded if its
+    /// timestep is a capture timestep.
+    /// @param max_steps The most timesteps to execute.
+    /// @param tolerance The relative change at or below which to stop.
+    /// @return Whether and after how many steps the state converged.
+    virtual Convergence RunUntilConverged(int max_steps, double tolerance) {
+        Convergence ret;
+        while (ret.steps < max_steps) {
+            const Eigen::MatrixXd before =
+                IsBatched() ? GetBatchState() : Eigen::MatrixXd(GetState());
+            RunTransitions();
+            ++ret.steps;
+            ret.change = GetRelativeChange(
+                before, IsBatched() ? GetBatchState()
+                                    : Eigen::MatrixXd(GetState()));
+            if (ret.change <= tolerance) {
+                ret.converged = true;
+                break;
+            }
+        }
+        return ret;
+    }
+
+    /// @brief Solves directly for the state a time-homogeneous model settles
+    /// at, without running it. The model must be finalized and have no change
+    /// times after its current timestep. A chain without inflow whose
+    /// matrices conserve the population settles at the equilibrium holding
+    /// the population of the current state.
+    /// @return The equilibrium state.
+    /// @throws std::runtime_error if the model does not support solving for
+    /// its equilibrium or it has no unique one.
+    virtual Eigen::VectorXd SolveEquilibrium() const {
+        std::string error_msg = "Model error: Model '" + GetModelName() +
+                                "' does not support equilibrium solves";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+
+    /// @brief Projects the state a number of steps ahead without changing the
+    /// model. The model must be finalized. Outcomes are reported for the
+    /// subscribed outcome channels.
+    /// @param steps The number of timesteps to look ahead.
+    /// @return The projected state and the outcomes accumulated on the way.
+    /// @throws std::runtime_error if the model does not support projections.
+    virtual Projection Project([[maybe_unused]] int steps) const {
+        std::string error_msg = "Model error: Model '" + GetModelName() +
+                                "' does not support projections";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+
+    /// @brief Selects expected-value or stochastic execution.
+    /// In a stochastic run behavior and intervention transitions move the
+    /// whole part of each source state with one multinomial draw, and
+    /// overdose and background death transitions remove people with binomial
+    /// draws; migration and custom transitions stay deterministic. Each draw
+    /// comes from the stream of its (timestep, transition, element) under
+    /// `key` (see RandomKey), so a run is reproducible from the key whatever
+    /// the threading, and scenarios run with one key use common random
+    /// numbers, batched scenarios included. Projections and equilibria stay
+    /// expected values.
+    /// @param mode The execution mode.
+    /// @param key The key of the random numbers of a stochastic run.
+    /// @throws std::runtime_error if the model cannot run stochastically.
+    virtual void
+    SetExecutionMode(ExecutionMode mode,
+                     [[maybe_unused]] const RandomKey &key = RandomKey()) {
+        if (mode == ExecutionMode::kExpectedValue) {
+            return;
+        }
+        std::string error_msg = "Model error: Model '" + GetModelName() +
+                                "' does not support stochastic execution";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+
+    /// @brief Retrieves the execution mode.
+    /// @return The mode selected by SetExecutionMode().
+    virtual ExecutionMode GetExecutionMode() const {
+        return ExecutionMode::kExpectedValue;
+    }
+
+    /// @brief Enables caching checkpoints while the model runs.
+    /// A checkpoint holds the state and histories at the timestep a run
+    /// starts from and at every change time it reaches, so
+    /// ReplaceTransition() can resume from there instead of timestep 0.
+    /// Anything that changes the run other than ReplaceTransition() drops
+    /// the checkpoints.
+    /// @param enabled Whether to take checkpoints.
+    /// @throws std::runtime_error if the model does not support checkpoints.
+    virtual void SetCheckpointing([[maybe_unused]] bool enabled) {
+        std::string error_msg = "Model error: Model '" + GetModelName() +
+                                "' does not support checkpoints";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+
+    /// @brief Replaces a transition whose effect changes only from a timestep
+    /// on, and re-simulates incrementally.
+    /// The model resumes from the latest checkpoint at or before
+    /// `change_time` and runs back to its current timestep, leaving state
+    /// and histories as if it had run from the start with the new
+    /// transition. A model that has not passed `change_time` yet only swaps
+    /// the transition.
+    /// @param index The position of the transition in the chain, as in
+    /// GetTransitionNames().
+    /// @param t The new transition. The model takes it over.
+    /// @param change_time The first timestep at which the new transition
+    /// differs from the old one.
+    /// @throws std::runtime_error if the index is out of range or no
+    /// checkpoint precedes `change_time`.
+    virtual void
+    ReplaceTransition([[maybe_unused]] std::size_t index,
+                      [[maybe_unused]] std::unique_ptr<Transition> &&t,
+                      [[maybe_unused]] int change_time) {
+        std::string error_msg = "Model error: Model '" + GetModelName() +
+                                "' does not support replacing transitions";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+
+    /// @brief Validates the transition chain, state and histories once and
+    /// switches RunTransitions() to an unchecked execution path.
+    /// The compiled plan is invalidated automatically when transitions are
+    /// added or cleared, or when the state or histories change dimension.
+    /// Assumes non-negative populations and probability-valued matrices.
+    /// @throws std::runtime_error if the model cannot be executed as
+    /// configured.
+    virtual void Finalize() = 0;
+
+    /// @brief Indicates whether the model is running its finalized plan.
+    /// @return True if Finalize() succeeded and nothing invalidated it since.
+    virtual bool IsFinalized() const = 0;
+
     /// @brief Adds a transition to the model.
     /// @param t A unique_ptr to a Transition object. The model assumes
     /// ownership.
     virtual void AddTransition(const std::unique_ptr<Transition> &t) = 0;
 
+    /// @brief Adds a transition to the model without copying it.
+    /// @param t A unique_ptr to a Transition object. The model takes it over
+    /// and t is left empty.
+    virtual void AddTransition(std::unique_ptr<Transition> &&t) = 0;
+
     /// @brief Retrieves the names of all registered transitions.
     /// @return Vector of transition names in the order they were added.
     virtual std::vector<std::string> GetTransitionNames() const = 0;
@@ -74,6 +289,19 @@ public:
     /// @brief Clears all history records and resets history tracking state.
     virtual void ClearHistories() = 0;
 
+    /// @brief Selects the history channels the model records.
+    /// Histories of other channels are dropped and never created, and the
+    /// transitions skip computing their outcomes. With no channel subscribed
+    /// a step runs the pure state update, e.g. for calibration runs that only
+    /// need the final state. All channels are subscribed by default.
+    /// @param channels The channels to record.
+    virtual void
+    SetSubscribedChannels(const std::vector<HistoryChannel> &channels) = 0;
+
+    /// @brief Retrieves the history channels the model records.
+    /// @return The subscribed channels, in HistoryChannel order.
+    virtual std::vector<HistoryChannel> GetSubscribedChannels() const = 0;
+
     /// @brief Sets the global history capture interval for this model.
     /// @param interval Record every interval timesteps. Values less than 1
     /// default to full capture.
@@ -106,6 +334,32 @@ public:
     static std::unique_ptr<Model>
     Create(const std::string &name, const std::string &log_name = "console");
 
+    /// @brief Factory method to create a Model storing its state and
+    /// histories at the requested precision.
+    /// Single precision models run their chain as a compiled pipeline (see
+    /// CompiledModel) and convert to double only at this interface.
+    /// @param name The name identifier for the model to create.
+    /// @param log_name Name of the logger for this model.
+    /// @param precision The precision of the stored state and histories.
+    /// @return A unique_ptr to the newly created Model instance.
+    static std::unique_ptr<Model> Create(const std::string &name,
+                                         const std::string &log_name,
+                                         Precision precision);
+
+    /// @brief Factory method to create a Model whose state size is fixed at
+    /// compile time, e.g. Model::Create<65>("model").
+    /// The model is a CompiledModel using fixed-size Eigen types throughout;
+    /// include <respond/compiled_model.hpp> to instantiate it.
+    /// @tparam Size The number of state elements.
+    /// @param name The name identifier for the model to create.
+    /// @param log_name Name of the logger for this model.
+    /// @param precision The precision of the stored state and histories.
+    /// @return A unique_ptr to the newly created Model instance.
+    template <int Size>
+    static std::unique_ptr<Model>
+    Create(const std::string &name, const std::string &log_name = "console",
+           Precision precision = Precision::kDouble);
+
     /// @brief Deleted copy constructor (models are non-copyable by public API).
     Model(const Model &) = delete;
     /// @brief Deleted copy assignment operator (models are non-copyable by
@@ -116,10 +370,32 @@ public:
     /// @return A unique_ptr to an independent copy of this model.
     virtual std::unique_ptr<Model> clone() const = 0;
 
+    /// @brief Branches the model at its current timestep.
+    /// The branch continues from the current state with copies of the
+    /// transitions, and behaves like a clone, but models that support it
+    /// share the history recorded so far with their branches instead of
+    /// copying it. GetHistories() of either model still returns the full
+    /// history. The default implementation clones the model.
+    /// @return A unique_ptr to the branch.
+    virtual std::unique_ptr<Model> Fork() { return clone(); }
+
 protected:
     /// @brief Protected default constructor for subclass initialization.
     /// Not intended for direct public use.
     Model() = default;
+
+    /// @brief Measures a step's change as RunUntilConverged() does.
+    /// @param before The state or batch states before the step.
+    /// @param after The state or batch states after the step.
+    /// @return The largest element-wise change relative to the largest
+    /// element before the step.
+    static double
+    GetRelativeChange(const Eigen::Ref<const Eigen::MatrixXd> &before,
+                      const Eigen::Ref<const Eigen::MatrixXd> &after) {
+        const double change = (after - before).lpNorm<Eigen::Infinity>();
+        const double scale = before.lpNorm<Eigen::Infinity>();
+        return (scale > 0.0) ? change / scale : change;
+    }
 };
 } // namespace respond
 
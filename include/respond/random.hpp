@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: random.hpp                                                           //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_RANDOM_HPP_
+#define RESPOND_RANDOM_HPP_
+
+#include <array>
+#include <cstdint>
+
+#include <Eigen/Core>
+
+namespace respond {
+/// @brief The Philox4x32-10 counter-based generator of Salmon et al. (2011).
+/// Each output block is a pure function of its counter and key, so any block
+/// of any stream can be generated without producing the blocks before it.
+/// @param counter The 128-bit counter of the block.
+/// @param key The 64-bit key of the stream family.
+/// @return Four independent, uniformly distributed 32-bit words.
+inline std::array<std::uint32_t, 4>
+Philox4x32(std::array<std::uint32_t, 4> counter,
+           std::array<std::uint32_t, 2> key) {
+    constexpr std::uint64_t kMultiplier0 = 0xD2511F53;
+    constexpr std::uint64_t kMultiplier1 = 0xCD9E8D57;
+    constexpr std::uint32_t kWeyl0 = 0x9E3779B9;
+    constexpr std::uint32_t kWeyl1 = 0xBB67AE85;
+    for (int round = 0; round < 10; ++round) {
+        const std::uint64_t product0 = kMultiplier0 * counter[0];
+        const std::uint64_t product1 = kMultiplier1 * counter[2];
+        counter = {static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^
+                       key[0],
+                   static_cast<std::uint32_t>(product1),
+                   static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^
+                       key[1],
+                   static_cast<std::uint32_t>(product0)};
+        key[0] += kWeyl0;
+        key[1] += kWeyl1;
+    }
+    return counter;
+}
+
+/// @brief A sequence of uniform random numbers at one coordinate of a
+/// counter-based stream family. Streams are cheap to construct and never
+/// share state, so they can be created where they are used, in any order and
+/// on any thread.
+class RandomStream {
+public:
+    /// @brief Constructs the stream at a coordinate.
+    /// @param key The key of the stream family.
+    /// @param coordinates The three counter words naming the stream; the
+    /// fourth counts the blocks drawn from it.
+    RandomStream(std::array<std::uint32_t, 2> key,
+                 std::array<std::uint32_t, 3> coordinates)
+        : _key(key), _coordinates(coordinates) {}
+
+    /// @brief Draws the next uniform number.
+    /// @return A double in the open interval (0, 1) with 53 random bits.
+    double Uniform() {
+        if (_next == 2) {
+            _block = Philox4x32({_blocks++, _coordinates[0], _coordinates[1],
+                                 _coordinates[2]},
+                                _key);
+            _next = 0;
+        }
+        const std::uint64_t bits =
+            (static_cast<std::uint64_t>(_block[2 * _next]) << 32) |
+            _block[2 * _next + 1];
+        ++_next;
+        return (static_cast<double>(bits >> 11) + 0.5) * 0x1.0p-53;
+    }
+
+private:
+    std::array<std::uint32_t, 2> _key;
+    std::array<std::uint32_t, 3> _coordinates;
+    std::array<std::uint32_t, 4> _block = {};
+    std::uint32_t _blocks = 0;
+    int _next = 2;
+};
+
+/// @brief Names the random numbers of one stochastic run.
+/// Every draw a model makes comes from the stream of its (timestep,
+/// transition, element) coordinate under this key, so a run is reproducible
+/// from the key alone, whatever the thread count or the order models are
+/// stepped in. Runs that share a key share their random numbers, which gives
+/// common random numbers across the scenarios of a comparison.
+struct RandomKey {
+    /// @brief The seed of the experiment.
+    std::uint32_t seed = 0;
+    /// @brief The replicate, giving independent realizations for one seed.
+    std::uint32_t replicate = 0;
+
+    /// @brief Retrieves the stream of one state element.
+    /// @param timestep The timestep being executed.
+    /// @param transition The position of the transition in the chain.
+    /// @param element The state element, e.g. the source state of a column.
+    /// @return The stream, positioned at its first draw.
+    RandomStream Stream(int timestep, int transition,
+                        Eigen::Index element) const {
+        return RandomStream({seed, replicate},
+                            {static_cast<std::uint32_t>(element),
+                             static_cast<std::uint32_t>(timestep),
+                             static_cast<std::uint32_t>(transition)});
+    }
+};
+
+/// @brief Draws from a binomial distribution.
+/// Small means are sampled by inversion and larger ones by Hörmann's BTRS
+/// transformed rejection, so the cost per draw stays bounded for populations
+/// of any size.
+/// @param trials The number of trials; a fractional part is dropped and
+/// non-positive values give 0.
+/// @param probability The success probability, clamped to [0, 1].
+/// @param stream The stream to draw from.
+/// @return The number of successes, as a whole-valued double.
+double SampleBinomial(double trials, double probability,
+                      RandomStream &stream);
+} // namespace respond
+
+#endif // RESPOND_RANDOM_HPP_
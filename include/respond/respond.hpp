@@ -4,7 +4,7 @@
 // Created Date: 2026-02-06                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-05-07                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -12,13 +12,21 @@
 #ifndef RESPOND_RESPOND_HPP_
 #define RESPOND_RESPOND_HPP_
 
+#include <respond/compiled_model.hpp>
 #include <respond/cost_effectiveness.hpp>
+#include <respond/dual.hpp>
+#include <respond/execution_context.hpp>
 #include <respond/history.hpp>
+#include <respond/history_recorder.hpp>
 #include <respond/logging.hpp>
 #include <respond/model.hpp>
+#include <respond/random.hpp>
 #include <respond/simulation.hpp>
+#include <respond/state_layout.hpp>
+#include <respond/threading.hpp>
 #include <respond/transition.hpp>
 #include <respond/transition_factory.hpp>
+#include <respond/typed_pipeline.hpp>
 #include <respond/version.hpp>
 
 #endif // RESPOND_RESPOND_HPP_
\ No newline at end of file
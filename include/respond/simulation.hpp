@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-02-12                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -12,6 +12,7 @@
 #ifndef RESPOND_SIMULATION_HPP_
 #define RESPOND_SIMULATION_HPP_
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
@@ -22,6 +23,7 @@
 
 #include <respond/history.hpp>
 #include <respond/model.hpp>
+#include <respond/threading.hpp>
 
 namespace respond {
 /// @brief Manages and executes multiple models in a coordinated simulation.
@@ -41,13 +43,43 @@ public:
     ~Simulation() = default;
 
     /// @brief Executes one step of the simulation for all models.
-    /// Calls RunTransitions() on each registered model in sequence.
+    /// Calls RunTransitions() on each registered model, spreading the models
+    /// over the workers of the threading policy. The workers are started
+    /// once by SetThreadingPolicy() and reused by every step. Models share
+    /// no state, so the results do not depend on the number of workers.
+    /// @throws The first exception thrown by a model, after every worker
+    /// has finished.
     void Run() {
-        for (const auto &model : _models) {
-            model->RunTransitions();
+        if (!_pool || _models.size() <= 1) {
+            for (const auto &model : _models) {
+                model->RunTransitions();
+            }
+            return;
         }
+        const std::size_t workers = _pool->size();
+        _pool->Run([this, workers](std::size_t w) {
+            for (std::size_t i = w; i < _models.size(); i += workers) {
+                _models[i]->RunTransitions();
+            }
+        });
     }
 
+    /// @brief Sets how the simulation uses the machine's cores and applies
+    /// its intra-op budget to Eigen. Models never change Eigen's thread
+    /// count themselves, so this is the one place it is configured.
+    /// Starts the model workers, which live until the policy is replaced or
+    /// the simulation is destroyed.
+    /// @param policy The threading policy to use.
+    void SetThreadingPolicy(const ThreadingPolicy &policy) {
+        _threading = policy;
+        _threading.Apply();
+        StartWorkers();
+    }
+
+    /// @brief Retrieves the threading policy of the simulation.
+    /// @return The policy, clamped to the machine.
+    const ThreadingPolicy &GetThreadingPolicy() const { return _threading; }
+
     /// @brief Adds a model to the simulation.
     /// The model is cloned and managed by the simulation.
     /// @param model A unique_ptr to a Model instance to add.
@@ -57,6 +89,13 @@ public:
         _models.push_back(model->clone());
     }
 
+    /// @brief Adds a model to the simulation without copying it.
+    /// The simulation takes over the model and leaves model empty.
+    /// @param model A unique_ptr to a Model instance to hand over.
+    void AddModel(std::unique_ptr<Model> &&model) {
+        _models.push_back(std::move(model));
+    }
+
     /// @brief Retrieves all models in the simulation.
     /// @return Const reference to the vector of Model unique_ptrs.
     const std::vector<std::unique_ptr<Model>> &GetModels() const {
@@ -128,7 +167,9 @@ public:
     /// @brief Copy constructor creating an independent deep copy of the
     /// simulation. All models are cloned; modifications to the copy do not
     /// affect the original.
-    Simulation(const Simulation &other) : _log_name(other.GetLogName()) {
+    Simulation(const Simulation &other)
+        : _log_name(other.GetLogName()), _threading(other._threading) {
+        StartWorkers();
         ClearModels();
         for (const auto &m : other.GetModels()) {
             _models.push_back(m->clone());
@@ -142,6 +183,8 @@ public:
         if (this != &other) {
             ClearModels();
             _log_name = other.GetLogName();
+            _threading = other._threading;
+            StartWorkers();
             for (const auto &m : other.GetModels()) {
                 _models.push_back(m->clone());
             }
@@ -151,7 +194,22 @@ public:
 
 private:
     std::string _log_name;
+    ThreadingPolicy _threading;
+    // null while models are stepped on the calling thread only
+    std::unique_ptr<WorkerPool> _pool;
     std::vector<std::unique_ptr<Model>> _models;
+
+    void StartWorkers() {
+        const auto workers =
+            static_cast<std::size_t>(_threading.GetModelWorkers());
+        if (_pool && _pool->size() == workers) {
+            return;
+        }
+        _pool.reset();
+        if (workers > 1) {
+            _pool = std::make_unique<WorkerPool>(workers);
+        }
+    }
 };
 } // namespace respond
 
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: state_layout.hpp                                                     //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_STATE_LAYOUT_HPP_
+#define RESPOND_STATE_LAYOUT_HPP_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include <respond/logging.hpp>
+
+namespace respond {
+/// @brief Describes the flat state vector as a tensor with named axes.
+/// Axes are stored row-major: the last axis varies fastest, so with axes
+/// (intervention, behavior) the element for intervention i and behavior b
+/// sits at index i * num_behaviors + b.
+class StateLayout {
+public:
+    /// @brief Constructs an empty layout.
+    StateLayout() = default;
+
+    /// @brief Constructs a layout from its axes in storage order.
+    /// @param axes Pairs of axis name and axis length, outermost first.
+    /// @param log_name The logger name for error reporting.
+    /// @throws std::runtime_error if an axis is empty or a name repeats.
+    explicit StateLayout(
+        const std::vector<std::pair<std::string, Eigen::Index>> &axes,
+        const std::string &log_name = "console")
+        : _axes(axes) {
+        for (std::size_t i = 0; i < _axes.size(); ++i) {
+            if (_axes[i].second < 1) {
+                std::string error_msg = "StateLayout error: Axis '" +
+                                        _axes[i].first +
+                                        "' must have a positive length";
+                LogError(log_name, error_msg);
+                throw std::runtime_error(error_msg);
+            }
+            for (std::size_t j = 0; j < i; ++j) {
+                if (_axes[j].first == _axes[i].first) {
+                    std::string error_msg = "StateLayout error: Axis '" +
+                                            _axes[i].first +
+                                            "' is defined more than once";
+                    LogError(log_name, error_msg);
+                    throw std::runtime_error(error_msg);
+                }
+            }
+        }
+    }
+
+    /// @brief Retrieves the total number of state elements.
+    /// @return The product of all axis lengths, 0 for an empty layout.
+    Eigen::Index Size() const {
+        if (_axes.empty()) {
+            return 0;
+        }
+        Eigen::Index size = 1;
+        for (const auto &axis : _axes) {
+            size *= axis.second;
+        }
+        return size;
+    }
+
+    /// @brief Retrieves the number of axes.
+    /// @return The axis count.
+    std::size_t AxisCount() const { return _axes.size(); }
+
+    /// @brief Looks up an axis by name.
+    /// @param name The axis name.
+    /// @return The position of the axis in storage order, or AxisCount() if
+    /// no axis has that name.
+    std::size_t FindAxis(const std::string &name) const {
+        for (std::size_t i = 0; i < _axes.size(); ++i) {
+            if (_axes[i].first == name) {
+                return i;
+            }
+        }
+        return _axes.size();
+    }
+
+    /// @brief Retrieves the name of an axis.
+    /// @param axis The position of the axis in storage order.
+    /// @return The axis name.
+    const std::string &AxisName(std::size_t axis) const {
+        return _axes[axis].first;
+    }
+
+    /// @brief Retrieves the length of an axis.
+    /// @param axis The position of the axis in storage order.
+    /// @return The number of entries along the axis.
+    Eigen::Index AxisSize(std::size_t axis) const {
+        return _axes[axis].second;
+    }
+
+    /// @brief Retrieves the distance between consecutive entries of an axis
+    /// in the flat state vector.
+    /// @param axis The position of the axis in storage order.
+    /// @return The product of the lengths of all faster-varying axes.
+    Eigen::Index Stride(std::size_t axis) const {
+        Eigen::Index stride = 1;
+        for (std::size_t i = axis + 1; i < _axes.size(); ++i) {
+            stride *= _axes[i].second;
+        }
+        return stride;
+    }
+
+    /// @brief Equality comparison operator.
+    /// @param other The layout to compare with.
+    /// @return True if both layouts have the same axes in the same order.
+    bool operator==(const StateLayout &other) const {
+        return _axes == other._axes;
+    }
+
+    /// @brief Inequality comparison operator.
+    /// @param other The layout to compare with.
+    /// @return True if the layouts differ.
+    bool operator!=(const StateLayout &other) const {
+        return !(*this == other);
+    }
+
+private:
+    std::vector<std::pair<std::string, Eigen::Index>> _axes;
+};
+} // namespace respond
+
+#endif // RESPOND_STATE_LAYOUT_HPP_
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: threading.hpp                                                        //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_THREADING_HPP_
+#define RESPOND_THREADING_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace respond {
+/// @brief Divides the machine's cores between the threads Eigen may use
+/// inside one matrix product (intra-op) and the workers that step different
+/// models at the same time (inter-model). Every worker can run a product
+/// with the full intra-op budget, so the product of the two is kept within
+/// the hardware thread count.
+class ThreadingPolicy {
+public:
+    /// @brief The default policy steps models one at a time with
+    /// single-threaded products.
+    ThreadingPolicy() : ThreadingPolicy(1, 1) {}
+
+    /// @brief Constructs a policy, clamping the budgets to the machine.
+    /// Each budget is at least 1; the intra-op budget is capped at the
+    /// hardware thread count and the workers at what remains for it.
+    /// @param intra_op_threads Threads per matrix product.
+    /// @param model_workers Models stepped concurrently.
+    ThreadingPolicy(int intra_op_threads, int model_workers) {
+        const int cores = GetHardwareThreads();
+        _intra_op_threads = std::clamp(intra_op_threads, 1, cores);
+        _model_workers =
+            std::clamp(model_workers, 1, cores / _intra_op_threads);
+    }
+
+    /// @brief Uses every core for concurrent models with single-threaded
+    /// products, the better split when there are more models than cores.
+    /// @return A policy with one worker per hardware thread.
+    static ThreadingPolicy ModelParallel() {
+        return ThreadingPolicy(1, GetHardwareThreads());
+    }
+
+    /// @brief Retrieves the number of threads per matrix product.
+    int GetIntraOpThreads() const { return _intra_op_threads; }
+
+    /// @brief Retrieves the number of models stepped concurrently.
+    int GetModelWorkers() const { return _model_workers; }
+
+    /// @brief Applies the intra-op budget to Eigen. Eigen's setting is
+    /// process-wide, which is why only the owner of the policy sets it.
+    void Apply() const { Eigen::setNbThreads(_intra_op_threads); }
+
+    /// @brief Retrieves the number of hardware threads.
+    /// @return std::thread::hardware_concurrency(), or 1 if it is unknown.
+    static int GetHardwareThreads() {
+        const auto count = std::thread::hardware_concurrency();
+        return (count == 0) ? 1 : static_cast<int>(count);
+    }
+
+private:
+    int _intra_op_threads;
+    int _model_workers;
+};
+
+/// @brief A fixed set of worker threads that is started once and reused for
+/// every parallel section, so stepping models concurrently does not create
+/// and join threads on each timestep. The calling thread takes part as
+/// worker 0, so a pool of N workers owns N - 1 threads.
+class WorkerPool {
+public:
+    /// @brief Starts the workers.
+    /// @param workers The number of workers, including the calling thread.
+    explicit WorkerPool(std::size_t workers)
+        : _workers(std::max<std::size_t>(workers, 1)),
+          _errors(_workers) {
+        for (std::size_t w = 1; w < _workers; ++w) {
+            _threads.emplace_back([this, w]() { Work(w); });
+        }
+    }
+
+    /// @brief Stops and joins the workers.
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _start.notify_all();
+        for (auto &thread : _threads) {
+            thread.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /// @brief Retrieves the number of workers, including the calling thread.
+    std::size_t size() const { return _workers; }
+
+    /// @brief Runs `task(w)` once for every worker index w and waits until
+    /// all of them have returned.
+    /// @param task The work of one worker, given its index.
+    /// @throws The first exception thrown by a worker, after every worker
+    /// has finished.
+    void Run(const std::function<void(std::size_t)> &task) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _task = &task;
+            _remaining = _workers - 1;
+            ++_generation;
+        }
+        _start.notify_all();
+        RunTask(0);
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this]() { return _remaining == 0; });
+            _task = nullptr;
+        }
+        for (auto &error : _errors) {
+            if (error) {
+                std::exception_ptr first = error;
+                std::fill(_errors.begin(), _errors.end(), nullptr);
+                std::rethrow_exception(first);
+            }
+        }
+    }
+
+private:
+    std::size_t _workers;
+    std::vector<std::thread> _threads;
+    std::vector<std::exception_ptr> _errors;
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    const std::function<void(std::size_t)> *_task = nullptr;
+    std::size_t _remaining = 0;
+    std::size_t _generation = 0;
+    bool _stopping = false;
+
+    void RunTask(std::size_t w) {
+        try {
+            (*_task)(w);
+        } catch (...) {
+            _errors[w] = std::current_exception();
+        }
+    }
+
+    // waits for each new generation of work until the pool is destroyed
+    void Work(std::size_t w) {
+        std::size_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _start.wait(lock, [&]() {
+                    return _stopping || _generation != seen;
+                });
+                if (_stopping) {
+                    return;
+                }
+                seen = _generation;
+            }
+            RunTask(w);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_remaining;
+            }
+            _done.notify_one();
+        }
+    }
+};
+} // namespace respond
+
+#endif // RESPOND_THREADING_HPP_
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-02                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -15,13 +15,28 @@
 
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
+#include <respond/execution_context.hpp>
 #include <respond/history.hpp>
+#include <respond/logging.hpp>
 
 namespace respond {
+/// @brief Identifies the kernel a transition implements, so compiled models
+/// can run built-in transitions with their own typed kernels.
+enum class TransitionKind : int {
+    kCustom = 0,         // Any other transition
+    kMigration = 1,      // Clamped element-wise addition
+    kBehavior = 2,       // Full matrix product
+    kIntervention = 3,   // Full matrix product recording admissions
+    kOverdose = 4,       // Element-wise removal of fatal overdoses
+    kBackgroundDeath = 5 // Element-wise removal of background deaths
+};
 
 /// @brief Abstract base class representing a state transition operation.
 /// Transitions apply transformation matrices to state vectors and update
@@ -43,12 +58,150 @@ public:
     Execute(const Eigen::Ref<const Eigen::VectorXd> &s,
             std::map<std::string, History> &h) const = 0;
 
+    /// @brief Executes this transition, writing the result into a
+    /// caller-owned buffer instead of allocating a new state vector.
+    /// Once `out` has been sized by a previous call, implementations must not
+    /// allocate. The default implementation forwards to Execute() so that
+    /// user-defined transitions keep working unchanged.
+    /// @param s The current state vector (not modified). Must not alias `out`.
+    /// @param out The buffer receiving the resulting state vector. Resized if
+    /// its dimension does not match the result.
+    /// @param ctx The execution context of the owning model.
+    virtual void ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                             Eigen::VectorXd &out,
+                             ExecutionContext &ctx) const {
+        out = Execute(s, ctx.histories);
+    }
+
+    /// @brief Checks once, ahead of execution, that this transition can be
+    /// applied to states of the given dimension.
+    /// Models call this from Finalize() so the per-step checks can be skipped
+    /// afterwards. The default implementation accepts any state dimension.
+    /// @param state_size The dimension of the state vector to be executed on.
+    /// @throws std::runtime_error if the transition is not applicable.
+    virtual void Validate([[maybe_unused]] Eigen::Index state_size) const {}
+
+    /// @brief Executes this transition without re-checking matrix counts or
+    /// dimensions.
+    /// Only valid once Validate() succeeded for the dimension of `s` and the
+    /// transition has not been modified since. The default implementation
+    /// forwards to ExecuteInto().
+    /// @param s The current state vector (not modified). Must not alias `out`.
+    /// @param out The buffer receiving the resulting state vector.
+    /// @param ctx The execution context of the owning model.
+    virtual void ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &s,
+                                  Eigen::VectorXd &out,
+                                  ExecutionContext &ctx) const {
+        ExecuteInto(s, out, ctx);
+    }
+
+    /// @brief Executes this transition on a batch of scenarios at once.
+    /// Each column of `s` is an independent state vector and column k writes
+    /// its outcomes to `ctx.histories[k]` through `ctx.slots[k]`. Built-in
+    /// transitions apply one matrix-matrix product or one column-wise sweep
+    /// to the whole batch. The default implementation runs ExecuteInto()
+    /// column by column.
+    /// @param s The current states, one per column (not modified). Must not
+    /// alias `out`.
+    /// @param out The buffer receiving the resulting states.
+    /// @param ctx The batch execution context of the owning model.
+    virtual void ExecuteBatch(const Eigen::Ref<const Eigen::MatrixXd> &s,
+                              Eigen::MatrixXd &out,
+                              BatchExecutionContext &ctx) const {
+        Eigen::VectorXd column;
+        for (Eigen::Index k = 0; k < s.cols(); ++k) {
+            ExecutionContext column_ctx(ctx.histories[k], ctx.slots[k],
+                                        ctx.timestep);
+            column_ctx.random = ctx.random;
+            column_ctx.transition = ctx.transition;
+            ExecuteInto(s.col(k), column, column_ctx);
+            if (k == 0) {
+                out.resize(column.size(), s.cols());
+            }
+            out.col(k) = column;
+        }
+    }
+
     /// @brief Adds a transformation matrix to this transition.
     /// The matrix is stored for use during Execute() calls.
     /// @param m The transition matrix to add (not modified by this transition).
     virtual void
     AddTransitionMatrix(const Eigen::Ref<const Eigen::MatrixXd> &m) = 0;
 
+    /// @brief Adds a sparse transformation matrix to this transition.
+    /// Behavior and intervention transitions keep the matrix in compressed
+    /// form and apply it as a sparse product. The default implementation
+    /// stores a dense copy through AddTransitionMatrix().
+    /// @param m The sparse transition matrix to add.
+    virtual void
+    AddSparseTransitionMatrix(const Eigen::SparseMatrix<double> &m) {
+        AddTransitionMatrix(Eigen::MatrixXd(m));
+    }
+
+    /// @brief Starts a new segment of this transition's matrix schedule.
+    /// Matrices added after this call replace the previous segment's from
+    /// timestep `change_time` on; the matrices added first apply from
+    /// timestep 0. Models select the segment for the current timestep before
+    /// each step (see SelectTimestep()). The default implementation does not
+    /// support schedules and throws.
+    /// @param change_time The timestep the new matrices take effect at. Must
+    /// be later than every earlier change time.
+    /// @throws std::runtime_error if the change time cannot be added.
+    virtual void AddChangeTime([[maybe_unused]] int change_time) {
+        std::string error_msg = "Transition error: Transition '" +
+                                GetTransitionName() +
+                                "' does not support change times";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+
+    /// @brief Retrieves the timesteps at which this transition's matrices
+    /// change.
+    /// @return The change times in increasing order, starting with 0.
+    virtual std::vector<int> GetChangeTimes() const { return {0}; }
+
+    /// @brief Activates the matrices in effect at a timestep.
+    /// Consecutive timesteps advance a cursor, so selecting costs O(1) and
+    /// copies nothing. The default implementation does nothing.
+    /// @param timestep The timestep about to be executed.
+    virtual void SelectTimestep([[maybe_unused]] int timestep) const {}
+
+    /// @brief Indicates whether this transition changes the state at a
+    /// timestep. Models skip inactive transitions without executing them, so
+    /// a transition that is the identity on most timesteps costs nothing on
+    /// those. The default is active on every timestep.
+    /// @param timestep The timestep about to be executed.
+    /// @return False if executing the transition would leave the state and
+    /// histories unchanged.
+    virtual bool IsActiveAt([[maybe_unused]] int timestep) const {
+        return true;
+    }
+
+    /// @brief Validates every segment of the schedule for a state size,
+    /// leaving the segment of timestep 0 selected.
+    /// @param state_size The dimension of the state vector to be executed on.
+    /// @throws std::runtime_error if any segment is not applicable.
+    void ValidateSchedule(Eigen::Index state_size) const {
+        for (int change_time : GetChangeTimes()) {
+            SelectTimestep(change_time);
+            Validate(state_size);
+        }
+        SelectTimestep(0);
+    }
+
+    /// @brief Identifies the built-in kernel this transition implements.
+    /// Compiled models run built-in kinds with typed kernels and call back
+    /// into ExecuteInto() for kCustom. The default is kCustom.
+    /// @return The kind of this transition.
+    virtual TransitionKind GetKind() const { return TransitionKind::kCustom; }
+
+    /// @brief Retrieves dense copies of the stored transition matrices.
+    /// @return The matrices in the order they were added. The default
+    /// implementation returns none.
+    virtual std::vector<Eigen::MatrixXd> CopyTransitionMatrices() const {
+        return {};
+    }
+
     /// @brief Retrieves the name/type of this transition.
     /// @return The transition's identifier as a string.
     virtual std::string GetTransitionName() const = 0;
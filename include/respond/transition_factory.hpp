@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-02-06                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -14,6 +14,7 @@
 
 #include <memory>
 
+#include <respond/state_layout.hpp>
 #include <respond/transition.hpp>
 
 namespace respond {
@@ -30,11 +31,50 @@ public:
     ///        - "intervention": Intervention-driven transitions
     ///        - "overdose": Overdose-related transitions
     ///        - "background_death": Background mortality transitions
+    ///        - "entering_cohort": Population injected from a time series
+    ///          stored sparsely, one injection per change time
     /// @param log_name The logger name for error reporting (e.g., "console").
     /// @return A unique_ptr to the created Transition, or nullptr if type is
     /// unsupported.
     static std::unique_ptr<Transition>
     CreateTransition(const std::string &type, const std::string &log_name);
+
+    /// @brief Creates a transition that acts along one axis of the state.
+    /// Instead of a full state-sized matrix it takes square matrices the
+    /// length of the axis: either one matrix shared by every slice of the
+    /// other axes, or one matrix per slice, ordered by the flat index of the
+    /// remaining axes.
+    /// @param type The type of transition to create. Supported types
+    /// (case-insensitive):
+    ///        - "behavior": Behavioral state transitions
+    ///        - "intervention": Intervention-driven transitions, recording
+    ///          intervention admissions
+    /// @param layout The layout of the state the transition applies to.
+    /// @param axis The name of the axis the matrices act along.
+    /// @param log_name The logger name for error reporting (e.g., "console").
+    /// @return A unique_ptr to the created Transition, or nullptr if the type
+    /// is unsupported.
+    /// @throws std::runtime_error if the axis is not part of the layout.
+    static std::unique_ptr<Transition>
+    CreateAxisTransition(const std::string &type, const StateLayout &layout,
+                         const std::string &axis, const std::string &log_name);
+
+    /// @brief Creates a transition that moves the population up one age
+    /// stratum every `interval` timesteps, e.g. the `aging_interval` of a
+    /// simulation configuration. The youngest stratum is emptied and the
+    /// oldest keeps its population. No matrices are added to it; strata are
+    /// moved as blocks of the state, and models skip the transition on
+    /// timesteps that are not a positive multiple of the interval.
+    /// @param layout The layout of the state the transition applies to.
+    /// @param axis The name of the age axis, ordered youngest first.
+    /// @param interval The number of timesteps between aging steps.
+    /// @param log_name The logger name for error reporting (e.g., "console").
+    /// @return A unique_ptr to the created Transition.
+    /// @throws std::runtime_error if the axis is not part of the layout or
+    /// the interval is not positive.
+    static std::unique_ptr<Transition>
+    CreateAgingTransition(const StateLayout &layout, const std::string &axis,
+                          int interval, const std::string &log_name);
 };
 } // namespace respond
 
@@ -0,0 +1,475 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: typed_pipeline.hpp                                                   //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_TYPED_PIPELINE_HPP_
+#define RESPOND_TYPED_PIPELINE_HPP_
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <respond/dual.hpp>
+#include <respond/elementwise_kernels.hpp>
+#include <respond/execution_context.hpp>
+#include <respond/history.hpp>
+#include <respond/transition.hpp>
+
+namespace respond {
+/// @brief A transition chain compiled into typed kernels.
+/// Built-in transitions (see TransitionKind) are copied into stages that
+/// store their matrices in the pipeline's scalar type and are dispatched
+/// through a closed std::variant, so a step makes no virtual calls and the
+/// compiler sees every kernel. Runs of consecutive element-wise stages are
+/// fused into one blocked sweep over the state. Custom transitions and
+/// transitions with change times run through their virtual double-precision
+/// ExecuteInto(), with the model selecting their segment each step.
+/// With a Dual scalar the pipeline propagates derivatives with respect to the
+/// matrix entries it was built to differentiate by; custom stages run in
+/// double precision and so cannot carry them.
+/// @tparam Scalar The floating point type states and matrices are held in.
+/// @tparam Size The state dimension if known at compile time. Fixed sizes
+/// store every stage in fixed-size Eigen types so products can be unrolled;
+/// they are meant for small states since the matrices are Size x Size.
+template <typename Scalar, int Size = Eigen::Dynamic> class TypedPipeline {
+public:
+    using Vector = Eigen::Matrix<Scalar, Size, 1>;
+    using Matrix = Eigen::Matrix<Scalar, Size, Size>;
+    using HistoryMap = std::map<std::string, BasicHistory<Scalar, Size>>;
+    using Slots = BasicHistorySlots<Scalar, Size>;
+
+    /// @brief Dynamically sized dense matrices with at most this fraction of
+    /// non-zero entries are applied in sparse form, matching the behavior and
+    /// intervention transitions.
+    static constexpr double kSparseDensityThreshold = 0.1;
+
+    /// @brief Number of state elements processed per block by fused stages.
+    static constexpr Eigen::Index kBlockSize = 256;
+
+    /// @brief Full matrix product, optionally recording admissions.
+    /// The operator is immutable once built and shared by copies of the
+    /// pipeline, so cloned models do not duplicate it.
+    struct MatrixStage {
+        std::shared_ptr<const Matrix> dense;
+        std::shared_ptr<const Eigen::SparseMatrix<Scalar, Eigen::RowMajor>>
+            sparse;
+        bool is_sparse = false;
+        bool record_admissions = false;
+    };
+    /// @brief Element-wise removal of fatal overdoses.
+    struct OverdoseStage {
+        Vector overdose;
+        Vector fatality;
+    };
+    /// @brief Element-wise removal of background deaths.
+    struct BackgroundDeathStage {
+        Vector rate;
+    };
+    /// @brief Clamped element-wise addition of migrants.
+    struct MigrationStage {
+        Vector migrants;
+    };
+    using ElementwiseStep =
+        std::variant<OverdoseStage, BackgroundDeathStage, MigrationStage>;
+    /// @brief Two or more consecutive element-wise stages, applied block by
+    /// block so each block of the state is read and written once.
+    struct FusedStage {
+        std::vector<ElementwiseStep> steps;
+    };
+    /// @brief Any other transition, executed through the virtual interface.
+    struct CustomStage {
+        const Transition *transition = nullptr;
+    };
+    using Stage = std::variant<MatrixStage, OverdoseStage, BackgroundDeathStage,
+                               MigrationStage, FusedStage, CustomStage>;
+
+    /// @brief Validates each transition for the state size and copies the
+    /// built-in ones into typed stages.
+    /// Custom transitions are referenced, not copied, and must outlive the
+    /// pipeline.
+    /// @param transitions The chain in execution order.
+    /// @param state_size The dimension of the states the chain will run on.
+    /// @param sensitivities The matrix entries to differentiate by, in
+    /// direction order; only a Dual scalar can carry them.
+    /// @throws std::runtime_error if a transition fails validation.
+    void Compile(const std::vector<std::unique_ptr<Transition>> &transitions,
+                 Eigen::Index state_size,
+                 const std::vector<SensitivityEntry> &sensitivities = {}) {
+        _stages.clear();
+        for (const auto &t : transitions) {
+            t->ValidateSchedule(state_size);
+        }
+        Build(transitions, sensitivities);
+    }
+
+    /// @brief Copies a chain into typed stages without validating it, for
+    /// callers that have already validated the chain for their state size.
+    /// @param transitions The chain in execution order.
+    /// @param sensitivities The matrix entries to differentiate by, which
+    /// must exist in the chain.
+    void Build(const std::vector<std::unique_ptr<Transition>> &transitions,
+               const std::vector<SensitivityEntry> &sensitivities = {}) {
+        Clear();
+        std::vector<ElementwiseStep> run;
+        auto close_run = [&]() {
+            if (run.size() == 1) {
+                std::visit([&](const auto &e) { _stages.emplace_back(e); },
+                           run.front());
+            } else if (run.size() > 1) {
+                _stages.emplace_back(FusedStage{run});
+            }
+            run.clear();
+        };
+        for (std::size_t i = 0; i < transitions.size(); ++i) {
+            Stage stage = MakeStage(*transitions[i], i, sensitivities);
+            const bool elementwise = std::visit(
+                [&](const auto &s) {
+                    if constexpr (std::is_constructible_v<
+                                      ElementwiseStep,
+                                      std::decay_t<decltype(s)>>) {
+                        run.emplace_back(s);
+                        return true;
+                    }
+                    return false;
+                },
+                stage);
+            if (!elementwise) {
+                close_run();
+                _stages.push_back(std::move(stage));
+            }
+        }
+        close_run();
+    }
+
+    /// @brief Removes every stage.
+    void Clear() {
+        _stages.clear();
+        _bound_histories = nullptr;
+    }
+
+    /// @brief Indicates whether a stage executes a transition through the
+    /// virtual interface. A pipeline without such stages references none of
+    /// the transitions it was built from, so copies of it can run on their
+    /// own and share its matrix stages.
+    /// @return True if a stage references a transition.
+    bool HasCustomStages() const {
+        return std::any_of(_stages.begin(), _stages.end(), [](const auto &s) {
+            return std::holds_alternative<CustomStage>(s);
+        });
+    }
+
+    /// @brief Retrieves the number of compiled stages.
+    /// @return The stage count.
+    std::size_t size() const { return _stages.size(); }
+
+    /// @brief Binds the double-precision histories custom stages record into
+    /// to a model's typed histories. The bound histories are reused every
+    /// step and what custom stages record is written back to the typed ones.
+    /// Models call this whenever they replace entries of their history map;
+    /// Run() binds on its own when handed another map or one whose entry
+    /// count changed.
+    /// @param histories The typed histories of the model.
+    void BindHistories(HistoryMap &histories) const {
+        _custom_histories.clear();
+        _custom_bindings.clear();
+        for (auto &kv : histories) {
+            History mirror(kv.first, kv.second.GetLogName(),
+                           kv.second.GetHistoryMode());
+            // snapshots continue the typed records, so records added at the
+            // next timestep land where they would in a double model
+            if (kv.second.GetHistoryMode() == HistoryMode::Snapshot) {
+                const auto &timesteps = kv.second.GetRecordedTimesteps();
+                const auto &states = kv.second.GetRecordedStates();
+                for (std::size_t i = 0; i < timesteps.size(); ++i) {
+                    mirror.AddState(states[i].template cast<double>(),
+                                    timesteps[i]);
+                }
+            }
+            auto &custom =
+                _custom_histories.emplace(kv.first, std::move(mirror))
+                    .first->second;
+            _custom_bindings.push_back(
+                {&custom, &kv.second, custom.GetRecordedStates().size()});
+        }
+        _custom_slots.Resolve(_custom_histories);
+        _bound_histories = &histories;
+    }
+
+    /// @brief Runs every stage once, in order.
+    /// @param state The state, replaced by the result of the chain.
+    /// @param scratch Ping-pong buffer the stages write into.
+    /// @param histories Histories the stages record outcomes to.
+    /// @param slots The channel slots of `histories`, resolved by the caller
+    /// whenever the history map changes.
+    /// @param timestep The timestep being executed, passed on to custom
+    /// stages.
+    void Run(Vector &state, Vector &scratch, HistoryMap &histories,
+             const Slots &slots, int timestep) const {
+        _timestep = timestep;
+        for (const auto &stage : _stages) {
+            const auto *custom = std::get_if<CustomStage>(&stage);
+            if (custom && !custom->transition->IsActiveAt(timestep)) {
+                continue;
+            }
+            std::visit(
+                [&](const auto &s) {
+                    Apply(s, state, scratch, histories, slots);
+                },
+                stage);
+            state.swap(scratch);
+        }
+    }
+
+private:
+    using Block = Eigen::Array<Scalar, Eigen::Dynamic, 1, 0, kBlockSize, 1>;
+
+    std::vector<Stage> _stages;
+    // scratch buffer for the stage-by-stage fallback of fused stages
+    mutable Vector _fused_fallback;
+    // A double-precision history custom stages record into and the typed
+    // history its records are written back to.
+    struct CustomBinding {
+        History *custom = nullptr;
+        typename Slots::HistoryType *typed = nullptr;
+        // snapshot records of `custom` already written back
+        std::size_t written = 0;
+    };
+
+    // double-precision buffers and histories for custom stages, kept across
+    // steps (see BindHistories())
+    mutable Eigen::VectorXd _custom_in;
+    mutable Eigen::VectorXd _custom_out;
+    mutable std::map<std::string, History> _custom_histories;
+    mutable std::vector<CustomBinding> _custom_bindings;
+    mutable HistorySlots _custom_slots;
+    mutable const HistoryMap *_bound_histories = nullptr;
+    mutable int _timestep = 0;
+
+    // Casts the matrices of the transition at `index` to Scalar and seeds
+    // the entries differentiated by. Returns whether any entry was seeded.
+    static bool TypedMatrices(
+        const Transition &t, std::size_t index,
+        const std::vector<SensitivityEntry> &sensitivities,
+        std::vector<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>
+            &typed) {
+        typed.clear();
+        for (const auto &m : t.CopyTransitionMatrices()) {
+            typed.push_back(m.template cast<Scalar>());
+        }
+        bool seeded = false;
+        if constexpr (IsDual<Scalar>::value) {
+            for (std::size_t d = 0; d < sensitivities.size(); ++d) {
+                const auto &entry = sensitivities[d];
+                if (entry.transition == index) {
+                    typed[entry.matrix](entry.row, entry.col)
+                        .SetDerivative(static_cast<int>(d), 1.0);
+                    seeded = true;
+                }
+            }
+        }
+        return seeded;
+    }
+
+    static Stage MakeStage(const Transition &t, std::size_t index,
+                           const std::vector<SensitivityEntry> &sensitivities) {
+        // stages hold one set of matrices, so schedules stay virtual
+        if (t.GetChangeTimes().size() > 1) {
+            return CustomStage{&t};
+        }
+        std::vector<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>
+            matrices;
+        const bool seeded = TypedMatrices(t, index, sensitivities, matrices);
+        switch (t.GetKind()) {
+        case TransitionKind::kBehavior:
+        case TransitionKind::kIntervention: {
+            MatrixStage stage;
+            auto dense = std::make_shared<Matrix>(matrices[0]);
+            stage.dense = dense;
+            // a seeded entry may be a structural zero, so seeded matrices
+            // stay dense
+            if constexpr (Size == Eigen::Dynamic) {
+                const auto non_zeros = (dense->array() != Scalar(0)).count();
+                if (!seeded && static_cast<double>(non_zeros) <=
+                                   kSparseDensityThreshold * dense->size()) {
+                    auto sparse = std::make_shared<
+                        Eigen::SparseMatrix<Scalar, Eigen::RowMajor>>(
+                        dense->sparseView());
+                    sparse->makeCompressed();
+                    stage.sparse = sparse;
+                    stage.dense.reset();
+                    stage.is_sparse = true;
+                }
+            }
+            stage.record_admissions =
+                t.GetKind() == TransitionKind::kIntervention;
+            return stage;
+        }
+        case TransitionKind::kOverdose:
+            return OverdoseStage{matrices[0].col(0), matrices[1].col(0)};
+        case TransitionKind::kBackgroundDeath:
+            return BackgroundDeathStage{matrices[0].col(0)};
+        case TransitionKind::kMigration:
+            return MigrationStage{matrices[0].col(0)};
+        default:
+            return CustomStage{&t};
+        }
+    }
+
+    static void Apply(const MatrixStage &s, const Vector &state, Vector &out,
+                      HistoryMap &, const Slots &slots) {
+        if (s.is_sparse) {
+            out.noalias() = *s.sparse * state;
+        } else {
+            out.noalias() = *s.dense * state;
+        }
+        auto *admissions = slots[HistoryChannel::kInterventionAdmission];
+        if (s.record_admissions && admissions) {
+            admissions->AccumulateState((out - state).cwiseMax(Scalar(0)));
+        }
+    }
+
+    static void Apply(const OverdoseStage &s, const Vector &state, Vector &out,
+                      HistoryMap &, const Slots &slots) {
+        out = state;
+        OverdoseKernel(out.array(), s.overdose.array(), s.fatality.array(),
+                       HistorySink(slots[HistoryChannel::kTotalOverdose]),
+                       HistorySink(slots[HistoryChannel::kFatalOverdose]));
+    }
+
+    static void Apply(const BackgroundDeathStage &s, const Vector &state,
+                      Vector &out, HistoryMap &, const Slots &slots) {
+        out = state;
+        BackgroundDeathKernel(
+            out.array(), s.rate.array(),
+            HistorySink(slots[HistoryChannel::kBackgroundDeath]));
+    }
+
+    static void Apply(const MigrationStage &s, const Vector &state,
+                      Vector &out, HistoryMap &, const Slots &) {
+        out = state;
+        MigrationKernel(out.array(), s.migrants.array());
+    }
+
+    // Snapshot-mode outcome histories cannot be written block by block, so a
+    // fused stage then runs its steps one after another.
+    void Apply(const FusedStage &s, const Vector &state, Vector &out,
+               HistoryMap &histories, const Slots &slots) const {
+        BlockOutcomes<Scalar> outcomes;
+        if (!ResolveBlockOutcomes(slots, state.size(), outcomes)) {
+            out = state;
+            for (const auto &step : s.steps) {
+                std::visit(
+                    [&](const auto &e) {
+                        Apply(e, out, _fused_fallback, histories, slots);
+                    },
+                    step);
+                out.swap(_fused_fallback);
+            }
+            return;
+        }
+        SweepBlocks<Scalar, kBlockSize>(
+            state, out, [&](Eigen::Index start, Block &block) {
+                for (const auto &step : s.steps) {
+                    std::visit(
+                        [&](const auto &e) {
+                            ApplyBlock(e, start, block, outcomes);
+                        },
+                        step);
+                }
+            });
+    }
+
+    static void ApplyBlock(const OverdoseStage &s, Eigen::Index start,
+                           Block &block,
+                           const BlockOutcomes<Scalar> &outcomes) {
+        const Eigen::Index length = block.size();
+        OverdoseKernel(block, s.overdose.segment(start, length).array(),
+                       s.fatality.segment(start, length).array(),
+                       AccumulatorSink(outcomes.total_overdose, start),
+                       AccumulatorSink(outcomes.fatal_overdose, start));
+    }
+
+    static void ApplyBlock(const BackgroundDeathStage &s, Eigen::Index start,
+                           Block &block,
+                           const BlockOutcomes<Scalar> &outcomes) {
+        BackgroundDeathKernel(
+            block, s.rate.segment(start, block.size()).array(),
+            AccumulatorSink(outcomes.background_death, start));
+    }
+
+    static void ApplyBlock(const MigrationStage &s, Eigen::Index start,
+                           Block &block, const BlockOutcomes<Scalar> &) {
+        MigrationKernel(block, s.migrants.segment(start, block.size()).array());
+    }
+
+    // Custom transitions record into the bound double histories; whatever
+    // they accumulate or snapshot is carried over into the typed histories
+    // afterwards, so a steady-state step allocates nothing.
+    void Apply(const CustomStage &s, const Vector &state, Vector &out,
+               HistoryMap &histories, const Slots &) const {
+        if (_bound_histories != &histories ||
+            _custom_bindings.size() != histories.size()) {
+            BindHistories(histories);
+        }
+        _custom_in = state.template cast<double>();
+        ExecutionContext ctx(_custom_histories, _custom_slots, _timestep);
+        s.transition->ExecuteInto(_custom_in, _custom_out, ctx);
+        out = _custom_out.template cast<Scalar>();
+        for (auto &binding : _custom_bindings) {
+            WriteBack(binding, _custom_in.size());
+        }
+        if (_custom_histories.size() != _custom_bindings.size()) {
+            AdoptNewHistories(histories);
+        }
+    }
+
+    static void WriteBack(CustomBinding &binding, Eigen::Index size) {
+        History &custom = *binding.custom;
+        if (custom.GetHistoryMode() == HistoryMode::Accumulated) {
+            if (!custom.HasPendingState()) {
+                return;
+            }
+            // zeroing rather than dropping the aggregate keeps its buffer
+            auto &pending = custom.GetPendingAccumulator(size);
+            binding.typed->AccumulateState(pending.template cast<Scalar>());
+            pending.setZero();
+            return;
+        }
+        const auto &timesteps = custom.GetRecordedTimesteps();
+        const auto &states = custom.GetRecordedStates();
+        for (; binding.written < timesteps.size(); ++binding.written) {
+            binding.typed->AddState(
+                states[binding.written].template cast<Scalar>(),
+                timesteps[binding.written]);
+        }
+    }
+
+    // Histories a custom transition added are added to the typed map too,
+    // carrying what was recorded into them, and the map is bound again.
+    void AdoptNewHistories(HistoryMap &histories) const {
+        for (const auto &kv : _custom_histories) {
+            if (histories.find(kv.first) == histories.end()) {
+                histories.emplace(kv.first,
+                                  typename HistoryMap::mapped_type(kv.second));
+            }
+        }
+        BindHistories(histories);
+    }
+};
+} // namespace respond
+
+#endif // RESPOND_TYPED_PIPELINE_HPP_
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: aging.cpp                                                            //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "internals/aging.hpp"
+
+#include <memory>
+#include <string>
+
+#include <respond/logging.hpp>
+
+namespace respond {
+void Aging::ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &state,
+                        Eigen::VectorXd &out, ExecutionContext &ctx) const {
+    Validate(state.size());
+    ExecuteUnchecked(state, out, ctx);
+}
+
+void Aging::Validate(Eigen::Index state_size) const {
+    if (!GetTransitionMatrices().empty()) {
+        std::string error_msg =
+            "Aging error: Expected no transition matrices, got " +
+            std::to_string(GetTransitionMatrices().size());
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    if (state_size != _layout.Size()) {
+        std::string error_msg =
+            "Aging error: State size (" + std::to_string(state_size) +
+            ") does not match the layout size (" +
+            std::to_string(_layout.Size()) + ")";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+void Aging::ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &state,
+                             Eigen::VectorXd &out,
+                             ExecutionContext &ctx) const {
+    // callers that do not skip inactive transitions still get the identity
+    if (!IsActiveAt(ctx.timestep)) {
+        out = state;
+        return;
+    }
+    Shift(state, out);
+}
+
+void Aging::ExecuteBatch(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                         Eigen::MatrixXd &out,
+                         BatchExecutionContext &ctx) const {
+    Validate(states.rows());
+    if (!IsActiveAt(ctx.timestep)) {
+        out = states;
+        return;
+    }
+    Shift(states, out);
+}
+
+template <typename In, typename Out>
+void Aging::Shift(const In &state, Out &out) const {
+    // View the state as outer x age x inner. For a fixed outer index the
+    // strata are consecutive blocks of `inner` rows, so strata 0..A-2 move
+    // down by one block in a single copy and the oldest block also keeps
+    // its own population.
+    const Eigen::Index ages = _layout.AxisSize(_axis);
+    const Eigen::Index inner = _layout.Stride(_axis);
+    const Eigen::Index outer = state.rows() / (ages * inner);
+    const Eigen::Index moved = (ages - 1) * inner;
+    out.resize(state.rows(), state.cols());
+    for (Eigen::Index o = 0; o < outer; ++o) {
+        const Eigen::Index start = o * ages * inner;
+        if (ages == 1) {
+            out.middleRows(start, inner) = state.middleRows(start, inner);
+            continue;
+        }
+        out.middleRows(start, inner).setZero();
+        out.middleRows(start + inner, moved) = state.middleRows(start, moved);
+        out.middleRows(start + moved, inner) +=
+            state.middleRows(start + moved, inner);
+    }
+}
+
+std::unique_ptr<Transition> Aging::Create(const std::string &name,
+                                          const StateLayout &layout,
+                                          const std::string &axis,
+                                          int interval,
+                                          const std::string &log_name) {
+    const std::size_t index = layout.FindAxis(axis);
+    if (index == layout.AxisCount()) {
+        std::string error_msg =
+            "Aging error: State layout has no axis named '" + axis + "'";
+        LogError(log_name, error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    if (interval < 1) {
+        std::string error_msg = "Aging error: Aging interval must be "
+                                "positive, got " +
+                                std::to_string(interval);
+        LogError(log_name, error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    return std::make_unique<Aging>(name, log_name, layout, index, interval);
+}
+} // namespace respond
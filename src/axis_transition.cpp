@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: axis_transition.cpp                                                  //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "internals/axis_transition.hpp"
+
+#include <memory>
+#include <string>
+
+#include <respond/logging.hpp>
+
+namespace respond {
+void AxisTransition::ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &state,
+                                 Eigen::VectorXd &out,
+                                 ExecutionContext &ctx) const {
+    Validate(state.size());
+    ExecuteUnchecked(state, out, ctx);
+}
+
+void AxisTransition::Validate(Eigen::Index state_size) const {
+    const Eigen::Index axis_size = _layout.AxisSize(_axis);
+    const auto slices =
+        static_cast<std::size_t>(_layout.Size() / axis_size);
+    const auto count = GetTransitionMatrices().size();
+    if (count != 1 && count != slices) {
+        std::string error_msg =
+            "Axis transition error: Expected 1 or " + std::to_string(slices) +
+            " transition matrices along axis '" + _layout.AxisName(_axis) +
+            "', got " + std::to_string(count);
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    for (const auto &m : GetTransitionMatrices()) {
+        if (m.rows() != axis_size || m.cols() != axis_size) {
+            std::string error_msg =
+                "Axis transition error: Transition matrices along axis '" +
+                _layout.AxisName(_axis) + "' must be " +
+                std::to_string(axis_size) + "x" + std::to_string(axis_size);
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+    }
+    if (state_size != _layout.Size()) {
+        std::string error_msg =
+            "Axis transition error: State size (" +
+            std::to_string(state_size) + ") does not match the layout size (" +
+            std::to_string(_layout.Size()) + ")";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+void AxisTransition::ExecuteUnchecked(
+    const Eigen::Ref<const Eigen::VectorXd> &state, Eigen::VectorXd &out,
+    ExecutionContext &ctx) const {
+    // View the state as outer x axis x inner, where inner spans the faster
+    // axes. For a fixed outer index the (inner x axis) block is a contiguous
+    // column-major matrix, so a shared matrix applies as one product per
+    // outer index and per-slice matrices apply to strided columns.
+    const auto &matrices = GetTransitionMatrices();
+    const Eigen::Index axis_size = _layout.AxisSize(_axis);
+    const Eigen::Index inner = _layout.Stride(_axis);
+    const Eigen::Index outer = state.size() / (axis_size * inner);
+    out.resize(state.size());
+    for (Eigen::Index o = 0; o < outer; ++o) {
+        const double *in_block = state.data() + o * axis_size * inner;
+        double *out_block = out.data() + o * axis_size * inner;
+        if (matrices.size() == 1) {
+            Eigen::Map<const Eigen::MatrixXd> x(in_block, inner, axis_size);
+            Eigen::Map<Eigen::MatrixXd> y(out_block, inner, axis_size);
+            y.noalias() = x * matrices[0].transpose();
+            continue;
+        }
+        for (Eigen::Index j = 0; j < inner; ++j) {
+            Eigen::Map<const Eigen::VectorXd, 0, Eigen::InnerStride<>> x(
+                in_block + j, axis_size, Eigen::InnerStride<>(inner));
+            Eigen::Map<Eigen::VectorXd, 0, Eigen::InnerStride<>> y(
+                out_block + j, axis_size, Eigen::InnerStride<>(inner));
+            y.noalias() = matrices[o * inner + j] * x;
+        }
+    }
+
+    // Add intervention_admissions to history if avaliable
+    auto *admissions = ctx.slots[HistoryChannel::kInterventionAdmission];
+    if (_record_admissions && admissions) {
+        admissions->AccumulateState((out - state).cwiseMax(0.0));
+    }
+}
+
+std::unique_ptr<Transition>
+AxisTransition::Create(const std::string &name, const StateLayout &layout,
+                       const std::string &axis, bool record_admissions,
+                       const std::string &log_name) {
+    const std::size_t index = layout.FindAxis(axis);
+    if (index == layout.AxisCount()) {
+        std::string error_msg = "Axis transition error: State layout has no "
+                                "axis named '" +
+                                axis + "'";
+        LogError(log_name, error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    return std::make_unique<AxisTransition>(name, log_name, layout, index,
+                                            record_admissions);
+}
+} // namespace respond
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -19,32 +19,122 @@
 #include <spdlog/spdlog.h>
 
 namespace respond {
-Eigen::VectorXd
-BackgroundDeath::Execute(const Eigen::Ref<const Eigen::VectorXd> &state,
-                         std::map<std::string, History> &h) const {
-    if (GetTransitionMatrices().size() != 1) {
+void BackgroundDeath::ExecuteInto(
+    const Eigen::Ref<const Eigen::VectorXd> &state, Eigen::VectorXd &out,
+    ExecutionContext &ctx) const {
+    CheckDimensions(state.size());
+    auto deaths = state.cwiseProduct(GetTransitionMatrices()[0]);
+    if (!(state.array() >= deaths.array()).all()) {
         std::string error_msg =
-            "Background death error: Expected 1 transition matrix, got " +
-            std::to_string(GetTransitionMatrices().size());
+            "Background death error: State values are less than estimated "
+            "deaths. " +
+            std::to_string((state.array() < deaths.array()).count()) +
+            " elements affected";
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-    auto deaths =
-        state.cwiseProduct(GetTransitionMatrices()[0]); // calculate the deaths
-    if (h.find("background_death") != h.end()) {
-        h["background_death"].AccumulateState(deaths);
+    ExecuteUnchecked(state, out, ctx);
+}
+
+void BackgroundDeath::Validate(Eigen::Index state_size) const {
+    CheckDimensions(state_size);
+    // With non-negative populations deaths can only exceed the state if the
+    // probability does, so checking the rates once replaces the per-step
+    // comparison against the state.
+    if ((GetTransitionMatrices()[0].array() > 1.0).any()) {
+        std::string error_msg =
+            "Background death error: Death probability exceeds 1 for " +
+            std::to_string(
+                (GetTransitionMatrices()[0].array() > 1.0).count()) +
+            " elements";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
     }
-    if (!(state.array() >= deaths.array()).all()) {
+}
+
+void BackgroundDeath::ExecuteUnchecked(
+    const Eigen::Ref<const Eigen::VectorXd> &state, Eigen::VectorXd &out,
+    ExecutionContext &ctx) const {
+    if (ctx.random) {
+        SampleInto(state, out, ctx);
+        return;
+    }
+    out = state;
+    BackgroundDeathKernel(
+        out.array(), GetTransitionMatrices()[0].col(0).array(),
+        HistorySink(ctx.slots[HistoryChannel::kBackgroundDeath]));
+}
+
+void BackgroundDeath::ExecuteBatch(
+    const Eigen::Ref<const Eigen::MatrixXd> &states, Eigen::MatrixXd &out,
+    BatchExecutionContext &ctx) const {
+    CheckDimensions(states.rows());
+    if (ctx.random) {
+        Transition::ExecuteBatch(states, out, ctx);
+        return;
+    }
+    // broadcast the per-element rates across every scenario column
+    auto deaths =
+        states.array().colwise() * GetTransitionMatrices()[0].col(0).array();
+    if (!(states.array() >= deaths).all()) {
         std::string error_msg =
             "Background death error: State values are less than estimated "
             "deaths. " +
-            std::to_string((state.array() < deaths.array()).count()) +
+            std::to_string((states.array() < deaths).count()) +
             " elements affected";
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-    auto new_state = state - deaths; // remove deaths from state
-    return new_state;
+    out = states;
+    for (Eigen::Index k = 0; k < states.cols(); ++k) {
+        BackgroundDeathKernel(
+            out.col(k).array(), GetTransitionMatrices()[0].col(0).array(),
+            HistorySink(ctx.slots[k][HistoryChannel::kBackgroundDeath]));
+    }
+}
+
+void BackgroundDeath::ApplyBlock(Eigen::Index start,
+                                 Eigen::Ref<Eigen::ArrayXd> block,
+                                 const FusedOutcomes &outcomes) const {
+    BackgroundDeathKernel(
+        block,
+        GetTransitionMatrices()[0].col(0).segment(start, block.size()).array(),
+        AccumulatorSink(outcomes.background_death, start));
+}
+
+void BackgroundDeath::SampleInto(
+    const Eigen::Ref<const Eigen::VectorXd> &state, Eigen::VectorXd &out,
+    ExecutionContext &ctx) const {
+    const auto &rate = GetTransitionMatrices()[0];
+    Eigen::VectorXd deaths(state.size());
+    for (Eigen::Index i = 0; i < state.size(); ++i) {
+        auto stream = ctx.random->Stream(ctx.timestep, ctx.transition, i);
+        deaths(i) = SampleBinomial(state(i), rate(i), stream);
+    }
+    if (auto *recorded = ctx.slots[HistoryChannel::kBackgroundDeath]) {
+        recorded->AccumulateState(deaths);
+    }
+    out = state - deaths;
+}
+
+void BackgroundDeath::CheckDimensions(Eigen::Index state_size) const {
+    if (GetTransitionMatrices().size() != 1) {
+        std::string error_msg =
+            "Background death error: Expected 1 transition matrix, got " +
+            std::to_string(GetTransitionMatrices().size());
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    if (state_size != GetTransitionMatrices()[0].size()) {
+        std::string error_msg = "Background death error: State size (" +
+                                std::to_string(state_size) +
+                                ") does not match transition matrix size (" +
+                                std::to_string(
+                                    GetTransitionMatrices()[0].size()) +
+                                ")";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
 }
 
 std::unique_ptr<Transition>
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -19,29 +19,64 @@
 #include <spdlog/spdlog.h>
 
 namespace respond {
-Eigen::VectorXd
-Behavior::Execute(const Eigen::Ref<const Eigen::VectorXd> &state,
-                  std::map<std::string, History> &h) const {
-    if (GetTransitionMatrices().size() != 1) {
+void Behavior::ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &state,
+                           Eigen::VectorXd &out, ExecutionContext &ctx) const {
+    Validate(state.rows());
+    ExecuteUnchecked(state, out, ctx);
+}
+
+void Behavior::Validate(Eigen::Index state_size) const {
+    if (GetOperators().size() != 1) {
         std::string error_msg =
             "Behavior error: Expected 1 transition matrix, got " +
-            std::to_string(GetTransitionMatrices().size());
+            std::to_string(GetOperators().size());
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-    if (state.rows() != GetTransitionMatrices()[0].cols()) {
+    if (state_size != GetOperators()[0].rows() ||
+        state_size != GetOperators()[0].cols()) {
         std::stringstream ss;
         ss << "Behavior error: State dimension mismatch. State size is ("
-           << state.rows() << ", " << state.cols()
-           << ") but transition matrix expects ("
-           << GetTransitionMatrices()[0].rows() << ", "
-           << GetTransitionMatrices()[0].cols() << ")";
+           << state_size << ", 1) but transition matrix expects ("
+           << GetOperators()[0].rows() << ", "
+           << GetOperators()[0].cols() << ")";
         std::string error_msg = ss.str();
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-    auto new_state = GetTransitionMatrices()[0] * state;
-    return new_state;
+}
+
+void Behavior::ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &state,
+                                Eigen::VectorXd &out,
+                                ExecutionContext &ctx) const {
+    if (ctx.random) {
+        SampleInto(state, out, ctx);
+        return;
+    }
+    GetOperators()[0].Apply(state, out);
+}
+
+void Behavior::ExecuteBatch(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                            Eigen::MatrixXd &out,
+                            BatchExecutionContext &ctx) const {
+    Validate(states.rows());
+    if (ctx.random) {
+        Transition::ExecuteBatch(states, out, ctx);
+        return;
+    }
+    GetOperators()[0].Apply(states, out);
+}
+
+void Behavior::SampleInto(const Eigen::Ref<const Eigen::VectorXd> &state,
+                          Eigen::VectorXd &out, ExecutionContext &ctx) const {
+    if (!GetOperators()[0].Sample(state, out, *ctx.random, ctx.timestep,
+                                  ctx.transition)) {
+        std::string error_msg =
+            "Behavior error: A column of the transition matrix sums to more "
+            "than 1, which a stochastic run cannot sample";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
 }
 
 std::unique_ptr<Transition> Behavior::Create(const std::string &name,
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: entering_cohort.cpp                                                  //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "internals/entering_cohort.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include <respond/logging.hpp>
+
+namespace respond {
+void EnteringCohort::ExecuteInto(
+    const Eigen::Ref<const Eigen::VectorXd> &state, Eigen::VectorXd &out,
+    ExecutionContext &ctx) const {
+    Validate(state.size());
+    ExecuteUnchecked(state, out, ctx);
+}
+
+void EnteringCohort::Validate(Eigen::Index state_size) const {
+    const auto &injections = _injections.Active();
+    if (injections.size() != 1) {
+        std::string error_msg =
+            "Entering cohort error: Expected 1 injection, got " +
+            std::to_string(injections.size());
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    if (injections[0].cols() != 1 || injections[0].rows() != state_size) {
+        std::string error_msg =
+            "Entering cohort error: Injection must be a " +
+            std::to_string(state_size) + "x1 vector, got " +
+            std::to_string(injections[0].rows()) + "x" +
+            std::to_string(injections[0].cols());
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+void EnteringCohort::ExecuteUnchecked(
+    const Eigen::Ref<const Eigen::VectorXd> &state, Eigen::VectorXd &out,
+    ExecutionContext &) const {
+    // the same clamp as Migration, touching only the injected entries
+    out = state.cwiseMax(0.0);
+    for (Eigen::SparseMatrix<double>::InnerIterator it(
+             _injections.Active()[0], 0);
+         it; ++it) {
+        out(it.index()) = std::max(state(it.index()) + it.value(), 0.0);
+    }
+}
+
+void EnteringCohort::ExecuteBatch(
+    const Eigen::Ref<const Eigen::MatrixXd> &states, Eigen::MatrixXd &out,
+    BatchExecutionContext &) const {
+    Validate(states.rows());
+    out = states.cwiseMax(0.0);
+    for (Eigen::SparseMatrix<double>::InnerIterator it(
+             _injections.Active()[0], 0);
+         it; ++it) {
+        out.row(it.index()) =
+            (states.row(it.index()).array() + it.value()).max(0.0).matrix();
+    }
+}
+
+void EnteringCohort::ApplyBlock(Eigen::Index start,
+                                Eigen::Ref<Eigen::ArrayXd> block,
+                                const FusedOutcomes &) const {
+    // entries are sorted, so the block's share of them is one contiguous run
+    const auto &injection = _injections.Active()[0];
+    const auto *indices = injection.innerIndexPtr();
+    const auto *values = injection.valuePtr();
+    const auto *end = indices + injection.nonZeros();
+    const auto *first = std::lower_bound(indices, end, start);
+    for (const auto *i = first; i != end && *i < start + block.size(); ++i) {
+        block(*i - start) += values[i - indices];
+    }
+    block = block.max(0.0);
+}
+
+std::unique_ptr<Transition>
+EnteringCohort::Create(const std::string &name, const std::string &log_name) {
+    return std::make_unique<EnteringCohort>(name, log_name);
+}
+} // namespace respond
@@ -0,0 +1,352 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: fast_forward.cpp                                                     //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "internals/fast_forward.hpp"
+
+#include <cmath>
+
+#include <Eigen/Eigenvalues>
+
+#include <respond/elementwise_kernels.hpp>
+
+namespace respond {
+namespace {
+// Steps still pay for dispatch and history bookkeeping on tiny states.
+constexpr double kStepOverhead = 64.0;
+
+// Eigenvectors closer to singular than this amplify rounding too much for the
+// closed form; it also rejects defective (non-diagonalizable) matrices.
+constexpr double kMinConditioning = 1e-8;
+
+// Column sums within this of 1 are taken to conserve the population.
+constexpr double kConservationTolerance = 1e-10;
+
+// Returns lambda^t, the sum of lambda^k over k < t and the sum of those
+// partial sums, by repeated squaring of the recurrence that produces them.
+// Unlike the geometric series formulas this stays accurate near lambda = 1.
+Eigen::Vector3cd GeometricSums(std::complex<double> lambda, int steps) {
+    Eigen::Matrix3cd recurrence = Eigen::Matrix3cd::Zero();
+    recurrence(0, 0) = lambda;
+    recurrence(1, 0) = recurrence(1, 1) = 1.0;
+    recurrence(2, 1) = recurrence(2, 2) = 1.0;
+    Eigen::Matrix3cd result = Eigen::Matrix3cd::Identity();
+    for (; steps > 0; steps >>= 1) {
+        if (steps & 1) {
+            result = recurrence * result;
+        }
+        recurrence = recurrence * recurrence;
+    }
+    return result.col(0);
+}
+
+// Sink adding the outcome of column c of the composed map to its outcome
+// rows starting at `offset`, or dropping it if the outcome is not recorded.
+auto OutcomeSink(Eigen::MatrixXd &step, Eigen::Index offset, Eigen::Index n,
+                 Eigen::Index c) {
+    return [&step, offset, n, c](const auto &outcome) {
+        if (offset >= 0) {
+            step.middleRows(offset, n).col(c) += outcome.matrix();
+        }
+    };
+}
+
+// Adds a channel to the recorded outcomes unless it is already there.
+// Returns false if the history cannot simply be summed into.
+bool AddOutcome(std::vector<std::pair<HistoryChannel, Eigen::Index>> &outcomes,
+                const HistorySlots &slots, HistoryChannel channel) {
+    const auto *history = slots[channel];
+    if (!history) {
+        return true;
+    }
+    if (history->GetHistoryMode() != HistoryMode::Accumulated) {
+        return false;
+    }
+    for (const auto &o : outcomes) {
+        if (o.first == channel) {
+            return true;
+        }
+    }
+    outcomes.emplace_back(channel, 0);
+    return true;
+}
+
+// Adds the admissions of an intervention, the positive part of its change
+// (M - I)x, to the admission rows of the composed map. With non-negative
+// matrices and states the positive part is linear in x for rows that cannot
+// lose people (M_ii >= 1: the change is (M - I)x itself) and for rows that
+// cannot gain any (no inflow: it is 0). Returns false if a row can do both.
+bool AddAdmissions(const Eigen::MatrixXd &matrix,
+                   const Eigen::Ref<const Eigen::MatrixXd> &x,
+                   const Eigen::MatrixXd &rows,
+                   Eigen::Ref<Eigen::MatrixXd> admissions) {
+    for (Eigen::Index i = 0; i < matrix.rows(); ++i) {
+        const double inflow = matrix.row(i).sum() - matrix(i, i);
+        if (matrix(i, i) >= 1.0) {
+            admissions.row(i) += rows.row(i) - x.row(i);
+        } else if (inflow > 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+bool FastForward::Analyze(
+    const std::vector<std::unique_ptr<Transition>> &chain,
+    Eigen::Index state_size, const HistorySlots &slots) {
+    _powers.clear();
+    _outcomes.clear();
+    _decomposed = false;
+    _size = state_size;
+    _dim = 0;
+    _step_cost = 0.0;
+    const Eigen::Index n = state_size;
+
+    // find out from the kinds alone whether the chain is affine, what it
+    // records and what a step costs
+    for (const auto &t : chain) {
+        bool recordable = true;
+        switch (t->GetKind()) {
+        case TransitionKind::kBehavior:
+            _step_cost += static_cast<double>(n) * n;
+            break;
+        case TransitionKind::kIntervention:
+            recordable = AddOutcome(_outcomes, slots,
+                                    HistoryChannel::kInterventionAdmission);
+            _step_cost += static_cast<double>(n) * n;
+            break;
+        case TransitionKind::kOverdose:
+            recordable =
+                AddOutcome(_outcomes, slots, HistoryChannel::kTotalOverdose) &&
+                AddOutcome(_outcomes, slots, HistoryChannel::kFatalOverdose);
+            _step_cost += static_cast<double>(n);
+            break;
+        case TransitionKind::kBackgroundDeath:
+            recordable = AddOutcome(_outcomes, slots,
+                                    HistoryChannel::kBackgroundDeath);
+            _step_cost += static_cast<double>(n);
+            break;
+        case TransitionKind::kMigration:
+            _step_cost += static_cast<double>(n);
+            break;
+        default:
+            return false;
+        }
+        if (!recordable) {
+            return false;
+        }
+        _step_cost += kStepOverhead;
+    }
+    for (std::size_t i = 0; i < _outcomes.size(); ++i) {
+        _outcomes[i].second = n * static_cast<Eigen::Index>(i + 1);
+    }
+    _dim = n * (static_cast<Eigen::Index>(_outcomes.size()) + 1) + 1;
+    return true;
+}
+
+bool FastForward::Compose(
+    const std::vector<std::unique_ptr<Transition>> &chain,
+    Eigen::Index state_size, const HistorySlots &slots) {
+    if (!Analyze(chain, state_size, slots)) {
+        return false;
+    }
+    const Eigen::Index n = state_size;
+    const Eigen::Index dim = _dim;
+    auto offset_of = [&](HistoryChannel channel) -> Eigen::Index {
+        for (const auto &o : _outcomes) {
+            if (o.first == channel) {
+                return o.second;
+            }
+        }
+        return -1;
+    };
+
+    // then apply each transition to the rows of the composed map
+    Eigen::MatrixXd step = Eigen::MatrixXd::Identity(dim, dim);
+    Eigen::MatrixXd rows;
+    for (const auto &t : chain) {
+        const auto matrices = t->CopyTransitionMatrices();
+        auto x = step.topRows(n);
+        switch (t->GetKind()) {
+        case TransitionKind::kBehavior:
+        case TransitionKind::kIntervention: {
+            if ((matrices[0].array() < 0.0).any()) {
+                return false;
+            }
+            rows.noalias() = matrices[0] * x;
+            const auto o =
+                offset_of(HistoryChannel::kInterventionAdmission);
+            if (t->GetKind() == TransitionKind::kIntervention && o >= 0 &&
+                !AddAdmissions(matrices[0], x, rows, step.middleRows(o, n))) {
+                return false;
+            }
+            x = rows;
+            break;
+        }
+        case TransitionKind::kOverdose: {
+            const auto total = offset_of(HistoryChannel::kTotalOverdose);
+            const auto fatal = offset_of(HistoryChannel::kFatalOverdose);
+            for (Eigen::Index c = 0; c < dim; ++c) {
+                OverdoseKernel(x.col(c).array(), matrices[0].col(0).array(),
+                               matrices[1].col(0).array(),
+                               OutcomeSink(step, total, n, c),
+                               OutcomeSink(step, fatal, n, c));
+            }
+            break;
+        }
+        case TransitionKind::kBackgroundDeath: {
+            const auto deaths = offset_of(HistoryChannel::kBackgroundDeath);
+            for (Eigen::Index c = 0; c < dim; ++c) {
+                BackgroundDeathKernel(x.col(c).array(),
+                                      matrices[0].col(0).array(),
+                                      OutcomeSink(step, deaths, n, c));
+            }
+            break;
+        }
+        case TransitionKind::kMigration:
+            // with a non-negative state the clamp at zero never binds, so
+            // migration only moves the constant column
+            if ((matrices[0].array() < 0.0).any()) {
+                return false;
+            }
+            MigrationKernel(step.col(dim - 1).head(n).array(),
+                            matrices[0].col(0).array());
+            break;
+        default:
+            return false;
+        }
+    }
+    _powers.push_back(std::move(step));
+    return true;
+}
+
+bool FastForward::IsWorthwhile(int steps, int chunk) const {
+    if (_dim == 0 || steps < 2) {
+        return false;
+    }
+    const double dim = static_cast<double>(_dim);
+    const double squarings = std::ceil(std::log2(chunk + 1.0));
+    const double chunks = std::ceil(static_cast<double>(steps) / chunk);
+    const double fast = squarings * dim * dim * dim +
+                        chunks * squarings * dim * dim;
+    return fast < steps * _step_cost;
+}
+
+void FastForward::Advance(Eigen::VectorXd &state, int steps,
+                          const HistorySlots &slots) {
+    const Eigen::Index dim = _powers.front().rows();
+    _augmented.setZero(dim);
+    _augmented.head(_size) = state;
+    _augmented(dim - 1) = 1.0;
+    // powers of one matrix commute, so the bits can be applied in any order
+    for (std::size_t j = 0; steps > 0; ++j, steps >>= 1) {
+        if (j == _powers.size()) {
+            _powers.push_back(_powers.back() * _powers.back());
+        }
+        if (steps & 1) {
+            _scratch.noalias() = _powers[j] * _augmented;
+            _augmented.swap(_scratch);
+        }
+    }
+    state = _augmented.head(_size);
+    for (const auto &o : _outcomes) {
+        slots[o.first]->AccumulateState(_augmented.segment(o.second, _size));
+    }
+}
+
+bool FastForward::AdvanceClosedForm(Eigen::VectorXd &state, int steps,
+                                    const HistorySlots &slots) {
+    if (!Decompose()) {
+        return false;
+    }
+    // with x' = Mx + b and M = VDV^-1, both the state after t steps and the
+    // sum of the states visited are diagonal in the eigenbasis
+    const auto &step = _powers.front();
+    const Eigen::Index n = _size;
+    const Eigen::Index constant = step.cols() - 1;
+    const Eigen::VectorXcd start =
+        _inverse_eigenvectors * state.cast<std::complex<double>>();
+    const Eigen::VectorXcd migrants =
+        _inverse_eigenvectors *
+        step.col(constant).head(n).cast<std::complex<double>>();
+    Eigen::VectorXcd end(n);
+    Eigen::VectorXcd visited(n);
+    for (Eigen::Index i = 0; i < n; ++i) {
+        const auto sums = GeometricSums(_eigenvalues(i), steps);
+        end(i) = sums(0) * start(i) + sums(1) * migrants(i);
+        visited(i) = sums(1) * start(i) + sums(2) * migrants(i);
+    }
+    state = (_eigenvectors * end).real();
+    if (_outcomes.empty()) {
+        return true;
+    }
+    const Eigen::VectorXd total = (_eigenvectors * visited).real();
+    for (const auto &o : _outcomes) {
+        const Eigen::VectorXd outcome =
+            step.block(o.second, 0, n, n) * total +
+            steps * step.col(constant).segment(o.second, n);
+        slots[o.first]->AccumulateState(outcome);
+    }
+    return true;
+}
+
+bool FastForward::Decompose() {
+    if (_decomposed) {
+        return _diagonalizable;
+    }
+    _decomposed = true;
+    _diagonalizable = false;
+    const Eigen::EigenSolver<Eigen::MatrixXd> solver(
+        _powers.front().topLeftCorner(_size, _size));
+    if (solver.info() != Eigen::Success) {
+        return false;
+    }
+    const Eigen::PartialPivLU<Eigen::MatrixXcd> lu(solver.eigenvectors());
+    if (!(lu.rcond() >= kMinConditioning)) {
+        return false;
+    }
+    _eigenvalues = solver.eigenvalues();
+    _eigenvectors = solver.eigenvectors();
+    _inverse_eigenvectors = lu.inverse();
+    _diagonalizable = true;
+    return true;
+}
+
+bool FastForward::SolveFixedPoint(const Eigen::VectorXd &state,
+                                  Eigen::VectorXd &fixed) const {
+    if (_powers.empty()) {
+        return false;
+    }
+    const auto &step = _powers.front();
+    const Eigen::Index n = _size;
+    const auto map = step.topLeftCorner(n, n);
+    const Eigen::VectorXd inflow = step.col(step.cols() - 1).head(n);
+    const Eigen::FullPivLU<Eigen::MatrixXd> lu(
+        Eigen::MatrixXd::Identity(n, n) - map);
+    if (lu.isInvertible()) {
+        fixed = lu.solve(inflow);
+        return true;
+    }
+    const bool conserving =
+        ((map.colwise().sum().array() - 1.0).abs() <= kConservationTolerance)
+            .all();
+    if (!conserving || !inflow.isZero() || lu.dimensionOfKernel() != 1) {
+        return false;
+    }
+    const Eigen::VectorXd kernel = lu.kernel().col(0);
+    if (kernel.sum() == 0.0) {
+        return false;
+    }
+    fixed = kernel * (state.sum() / kernel.sum());
+    return true;
+}
+} // namespace respond
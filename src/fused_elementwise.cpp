@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: fused_elementwise.cpp                                                //
+// Project: respond                                                           //
+// Created Date: 2026-10-16                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "internals/fused_elementwise.hpp"
+
+#include <respond/history.hpp>
+
+namespace respond {
+void FusedElementwise::Execute(const Eigen::Ref<const Eigen::VectorXd> &in,
+                               Eigen::VectorXd &out,
+                               ExecutionContext &ctx) const {
+    FusedOutcomes outcomes;
+    if (!ResolveBlockOutcomes(ctx.slots, in.size(), outcomes)) {
+        out = in;
+        for (const auto *t : _transitions) {
+            t->ExecuteUnchecked(out, _fallback, ctx);
+            out.swap(_fallback);
+        }
+        return;
+    }
+    SweepBlocks<double, kBlockSize>(
+        in, out, [&](Eigen::Index start, Eigen::Ref<Eigen::ArrayXd> block) {
+            for (const auto *stage : _stages) {
+                stage->ApplyBlock(start, block, outcomes);
+            }
+        });
+}
+} // namespace respond
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: aging.hpp                                                            //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_INTERNALS_AGING_HPP_
+#define RESPOND_INTERNALS_AGING_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <respond/state_layout.hpp>
+
+#include "transition_base.hpp"
+
+namespace respond {
+// Moves everyone up one stratum along the age axis of the state every
+// `interval` timesteps. The youngest stratum is emptied and the oldest keeps
+// its population. Each stratum is a contiguous block of the state for a
+// fixed index of the slower axes, so aging is a block move and no matrix is
+// stored or multiplied. On every other timestep the transition is inactive
+// (see IsActiveAt()) and models skip it.
+class Aging : public virtual TransitionBase {
+public:
+    Aging(const std::string &name, const std::string &log_name,
+          const StateLayout &layout, std::size_t axis, int interval)
+        : TransitionBase(name, log_name), _layout(layout), _axis(axis),
+          _interval(interval) {}
+
+    // Run the execute function and write the final state into out. Do not
+    // edit the parameter state, but do edit the history provided. Nothing in
+    // the Transition object should change.
+    void ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                     Eigen::VectorXd &out,
+                     ExecutionContext &ctx) const override;
+
+    // Check the state size against the layout. Throws if the transition
+    // cannot be applied.
+    void Validate(Eigen::Index state_size) const override;
+
+    // The execute kernel without any checks, used by finalized models.
+    void ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &s,
+                          Eigen::VectorXd &out,
+                          ExecutionContext &ctx) const override;
+
+    // The same block move applied to the rows of a batched state.
+    void ExecuteBatch(const Eigen::Ref<const Eigen::MatrixXd> &s,
+                      Eigen::MatrixXd &out,
+                      BatchExecutionContext &ctx) const override;
+
+    // Aging happens at every positive multiple of the interval.
+    bool IsActiveAt(int timestep) const override {
+        return timestep > 0 && timestep % _interval == 0;
+    }
+
+    // Clone
+    std::unique_ptr<Transition> clone() const override {
+        auto ret = std::make_unique<Aging>(GetTransitionName(), GetLogName(),
+                                           _layout, _axis, _interval);
+        CopyTransitionMatricesTo(*ret);
+        return ret;
+    }
+
+    /// @brief Factory method to create an aging transition.
+    /// @param name The name of the transition.
+    /// @param layout The layout of the state the transition applies to.
+    /// @param axis The name of the age axis, ordered youngest first.
+    /// @param interval The number of timesteps between aging steps.
+    /// @param log_name Name of the logger to write errors to.
+    /// @return An instance of Aging.
+    /// @throws std::runtime_error if the axis is not part of the layout or
+    /// the interval is not positive.
+    static std::unique_ptr<Transition>
+    Create(const std::string &name, const StateLayout &layout,
+           const std::string &axis, int interval,
+           const std::string &log_name = "console");
+
+private:
+    StateLayout _layout;
+    std::size_t _axis;
+    int _interval;
+
+    // shifts the rows of `s` up one age stratum into `out`
+    template <typename In, typename Out>
+    void Shift(const In &s, Out &out) const;
+};
+} // namespace respond
+
+#endif // RESPOND_INTERNALS_AGING_HPP_
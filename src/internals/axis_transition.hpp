@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: axis_transition.hpp                                                  //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_INTERNALS_AXIS_TRANSITION_HPP_
+#define RESPOND_INTERNALS_AXIS_TRANSITION_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <respond/state_layout.hpp>
+
+#include "transition_base.hpp"
+
+namespace respond {
+// Applies a small square matrix along one axis of the state tensor (a mode-n
+// product) instead of a full state-sized operator. Either one matrix is
+// shared by every slice of the other axes, or one matrix is given per slice,
+// ordered by the flat index of the remaining axes.
+class AxisTransition : public virtual TransitionBase {
+public:
+    AxisTransition(const std::string &name, const std::string &log_name,
+                   const StateLayout &layout, std::size_t axis,
+                   bool record_admissions)
+        : TransitionBase(name, log_name), _layout(layout), _axis(axis),
+          _record_admissions(record_admissions) {}
+
+    // Run the execute function and write the final state into out. Do not
+    // edit the parameter state, but do edit the history provided. Nothing in
+    // the Transition object should change.
+    void ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                     Eigen::VectorXd &out,
+                     ExecutionContext &ctx) const override;
+
+    // Check the matrix count and dimensions against a state size. Throws if
+    // the transition cannot be applied.
+    void Validate(Eigen::Index state_size) const override;
+
+    // The execute kernel without any checks, used by finalized models.
+    void ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &s,
+                          Eigen::VectorXd &out,
+                          ExecutionContext &ctx) const override;
+
+    // Clone
+    std::unique_ptr<Transition> clone() const override {
+        auto ret = std::make_unique<AxisTransition>(
+            GetTransitionName(), GetLogName(), _layout, _axis,
+            _record_admissions);
+        CopyTransitionMatricesTo(*ret);
+        return ret;
+    }
+
+    /// @brief Factory method to create an axis transition.
+    /// @param name The name of the transition.
+    /// @param layout The layout of the state the transition applies to.
+    /// @param axis The name of the axis the matrices act along.
+    /// @param record_admissions Whether to record intervention admissions.
+    /// @param log_name Name of the logger to write errors to.
+    /// @return An instance of AxisTransition.
+    /// @throws std::runtime_error if the axis is not part of the layout.
+    static std::unique_ptr<Transition>
+    Create(const std::string &name, const StateLayout &layout,
+           const std::string &axis, bool record_admissions,
+           const std::string &log_name = "console");
+
+private:
+    StateLayout _layout;
+    std::size_t _axis;
+    bool _record_admissions;
+};
+} // namespace respond
+
+#endif // RESPOND_INTERNALS_AXIS_TRANSITION_HPP_
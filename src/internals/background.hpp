@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -14,27 +14,51 @@
 
 #include <memory>
 
+#include "fused_elementwise.hpp"
 #include "transition_base.hpp"
 
 namespace respond {
-class BackgroundDeath : public virtual TransitionBase {
+class BackgroundDeath : public virtual TransitionBase,
+                        public ElementwiseTransition {
 public:
     BackgroundDeath(const std::string &name, const std::string &log_name)
         : TransitionBase(name, log_name) {}
 
-    // Run the execute function and return the final state. Do not edit the
-    // parameter state, but do edit the history provided. Nothing in the
-    // Transition object should change.
-    Eigen::VectorXd Execute(const Eigen::Ref<const Eigen::VectorXd> &s,
-                            std::map<std::string, History> &h) const override;
+    // Run the execute function and write the final state into out. Do not
+    // edit the parameter state, but do edit the history provided. Nothing in
+    // the Transition object should change.
+    void ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                     Eigen::VectorXd &out,
+                     ExecutionContext &ctx) const override;
+
+    // Check the matrix count and dimensions against a state size. Throws if
+    // the transition cannot be applied.
+    void Validate(Eigen::Index state_size) const override;
+
+    // The execute kernel without any checks, used by finalized models.
+    void ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &s,
+                          Eigen::VectorXd &out,
+                          ExecutionContext &ctx) const override;
+
+    // The kernel applied column-wise to every scenario of a batched state.
+    void ExecuteBatch(const Eigen::Ref<const Eigen::MatrixXd> &s,
+                      Eigen::MatrixXd &out,
+                      BatchExecutionContext &ctx) const override;
+
+    // The same kernel applied in place to one block of the state, used when
+    // the model fuses consecutive element-wise transitions.
+    void ApplyBlock(Eigen::Index start, Eigen::Ref<Eigen::ArrayXd> block,
+                    const FusedOutcomes &outcomes) const override;
+
+    TransitionKind GetKind() const override {
+        return TransitionKind::kBackgroundDeath;
+    }
 
     // Clone
     std::unique_ptr<Transition> clone() const override {
         auto ret = std::make_unique<BackgroundDeath>(GetTransitionName(),
                                                      GetLogName());
-        for (const auto &t : GetTransitionMatrices()) {
-            ret->AddTransitionMatrix(t);
-        }
+        CopyTransitionMatricesTo(*ret);
         return ret;
     }
 
@@ -43,6 +67,13 @@ public:
     /// @return An instance of Markov.
     static std::unique_ptr<Transition>
     Create(const std::string &name, const std::string &log_name = "console");
+
+private:
+    // Matrix count and size checks shared by ExecuteInto and Validate.
+    void CheckDimensions(Eigen::Index state_size) const;
+    // The stochastic kernel: binomial draws per state element.
+    void SampleInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                    Eigen::VectorXd &out, ExecutionContext &ctx) const;
 };
 } // namespace respond
 
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -14,27 +14,45 @@
 
 #include <memory>
 
-#include "transition_base.hpp"
+#include "matrix_transition.hpp"
 
 namespace respond {
-class Behavior : public virtual TransitionBase {
+class Behavior : public MatrixTransition {
 public:
     Behavior(const std::string &name, const std::string &log_name)
-        : TransitionBase(name, log_name) {}
+        : TransitionBase(name, log_name), MatrixTransition(name, log_name) {}
 
-    // Run the execute function and return the final state. Do not edit the
-    // parameter state, but do edit the history provided. Nothing in the
-    // Transition object should change.
-    Eigen::VectorXd Execute(const Eigen::Ref<const Eigen::VectorXd> &s,
-                            std::map<std::string, History> &h) const override;
+    // Run the execute function and write the final state into out. Do not
+    // edit the parameter state, but do edit the history provided. Nothing in
+    // the Transition object should change.
+    void ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                     Eigen::VectorXd &out,
+                     ExecutionContext &ctx) const override;
+
+    // Check the matrix count and dimensions against a state size. Throws if
+    // the transition cannot be applied.
+    void Validate(Eigen::Index state_size) const override;
+
+    // The execute kernel without any checks, used by finalized models.
+    void ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &s,
+                          Eigen::VectorXd &out,
+                          ExecutionContext &ctx) const override;
+
+    // The kernel applied to every column of a batched state as one
+    // matrix-matrix product.
+    void ExecuteBatch(const Eigen::Ref<const Eigen::MatrixXd> &s,
+                      Eigen::MatrixXd &out,
+                      BatchExecutionContext &ctx) const override;
+
+    TransitionKind GetKind() const override {
+        return TransitionKind::kBehavior;
+    }
 
     // Clone
     std::unique_ptr<Transition> clone() const override {
         auto ret =
             std::make_unique<Behavior>(GetTransitionName(), GetLogName());
-        for (const auto &t : GetTransitionMatrices()) {
-            ret->AddTransitionMatrix(t);
-        }
+        CopyOperatorsTo(*ret);
         return ret;
     }
 
@@ -43,6 +61,11 @@ public:
     /// @return An instance of Markov.
     static std::unique_ptr<Transition>
     Create(const std::string &name, const std::string &log_name = "console");
+
+private:
+    // The stochastic kernel: one multinomial draw per source state.
+    void SampleInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                    Eigen::VectorXd &out, ExecutionContext &ctx) const;
 };
 } // namespace respond
 
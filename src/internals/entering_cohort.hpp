@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: entering_cohort.hpp                                                  //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_INTERNALS_ENTERING_COHORT_HPP_
+#define RESPOND_INTERNALS_ENTERING_COHORT_HPP_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Sparse>
+
+#include "fused_elementwise.hpp"
+#include "schedule.hpp"
+#include "transition_base.hpp"
+
+namespace respond {
+// Adds an entering cohort (or any population change) to the state each
+// timestep. The injection is a time series given only at its change times,
+// and each injection keeps only its non-zero entries as a sparse column.
+// The model's timestep advances a cursor through the series, so no vector
+// the size of the state is held per timestep. The kernel is the clamped
+// addition of Migration, so the transition runs as a migration kernel
+// wherever a chain is compiled.
+class EnteringCohort : public virtual TransitionBase,
+                       public ElementwiseTransition {
+public:
+    EnteringCohort(const std::string &name, const std::string &log_name)
+        : TransitionBase(name, log_name) {}
+
+    // Run the execute function and write the final state into out. Do not
+    // edit the parameter state, but do edit the history provided. Nothing in
+    // the Transition object should change.
+    void ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                     Eigen::VectorXd &out,
+                     ExecutionContext &ctx) const override;
+
+    // Check the injection count and dimensions against a state size. Throws
+    // if the transition cannot be applied.
+    void Validate(Eigen::Index state_size) const override;
+
+    // The execute kernel without any checks, used by finalized models.
+    void ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &s,
+                          Eigen::VectorXd &out,
+                          ExecutionContext &ctx) const override;
+
+    // The kernel applied row-wise to every scenario of a batched state.
+    void ExecuteBatch(const Eigen::Ref<const Eigen::MatrixXd> &s,
+                      Eigen::MatrixXd &out,
+                      BatchExecutionContext &ctx) const override;
+
+    // Adds the injected entries that fall into one block of the state, used
+    // when the model fuses consecutive element-wise transitions.
+    void ApplyBlock(Eigen::Index start, Eigen::Ref<Eigen::ArrayXd> block,
+                    const FusedOutcomes &outcomes) const override;
+
+    // Dense injections are stored by their non-zero entries.
+    void
+    AddTransitionMatrix(const Eigen::Ref<const Eigen::MatrixXd> &m) override {
+        AddSparseTransitionMatrix(m.sparseView());
+    }
+    // Kept compressed so a block's entries are one contiguous run.
+    void
+    AddSparseTransitionMatrix(const Eigen::SparseMatrix<double> &m) override {
+        Eigen::SparseMatrix<double> injection = m;
+        injection.makeCompressed();
+        _injections.Add(std::move(injection));
+    }
+    // Injections added from here on apply from change_time on.
+    void AddChangeTime(int change_time) override {
+        if (!_injections.AddChangeTime(change_time)) {
+            ThrowInvalidChangeTime(change_time);
+        }
+    }
+    std::vector<int> GetChangeTimes() const override {
+        return _injections.GetChangeTimes();
+    }
+    void SelectTimestep(int timestep) const override {
+        _injections.Select(timestep);
+    }
+    void ClearTransitionMatrices() override { _injections.Clear(); }
+
+    // A dense copy of the active injection, for compiling the chain.
+    std::vector<Eigen::MatrixXd> CopyTransitionMatrices() const override {
+        std::vector<Eigen::MatrixXd> ret;
+        for (const auto &m : _injections.Active()) {
+            ret.emplace_back(m);
+        }
+        return ret;
+    }
+
+    TransitionKind GetKind() const override {
+        return TransitionKind::kMigration;
+    }
+
+    // Clone
+    std::unique_ptr<Transition> clone() const override {
+        auto ret = std::make_unique<EnteringCohort>(GetTransitionName(),
+                                                    GetLogName());
+        ret->_injections = _injections;
+        return ret;
+    }
+
+    /// @brief Factory method to create an entering cohort transition.
+    /// @param name The name of the transition.
+    /// @param log_name Name of the logger to write errors to.
+    /// @return An instance of EnteringCohort.
+    static std::unique_ptr<Transition>
+    Create(const std::string &name, const std::string &log_name = "console");
+
+private:
+    Schedule<Eigen::SparseMatrix<double>> _injections;
+};
+} // namespace respond
+
+#endif // RESPOND_INTERNALS_ENTERING_COHORT_HPP_
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: fast_forward.hpp                                                     //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_INTERNALS_FAST_FORWARD_HPP_
+#define RESPOND_INTERNALS_FAST_FORWARD_HPP_
+
+#include <complex>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include <respond/history.hpp>
+#include <respond/transition.hpp>
+
+namespace respond {
+/// @brief Advances a chain of built-in transitions many steps at once.
+/// Between change times a chain without custom transitions applies the same
+/// affine map every step. The map is composed into one augmented matrix
+/// acting on [state; outcome accumulators; 1], so that powers of it advance
+/// the state and sum the recorded outcomes over any number of steps. Powers
+/// of two are formed by repeated squaring and applied to the vector, so
+/// advancing k steps costs O(log k) matrix-vector products.
+class FastForward {
+public:
+    /// @brief Checks from the transition kinds alone whether a chain can be
+    /// composed and estimates the cost of stepping it, without copying any
+    /// matrix. Call IsWorthwhile() afterwards to skip building the augmented
+    /// matrix of a segment that would be stepped anyway.
+    /// @param chain The transitions, with their current segment selected.
+    /// @param state_size The dimension of the state.
+    /// @param slots The channel histories of the model; outcomes are only
+    /// accumulated for channels that are recorded.
+    /// @return False if a transition is custom or an outcome history cannot
+    /// be summed into.
+    bool Analyze(const std::vector<std::unique_ptr<Transition>> &chain,
+                 Eigen::Index state_size, const HistorySlots &slots);
+
+    /// @brief Composes the one-step map of a validated chain.
+    /// Fails if a transition is custom or could act non-linearly: matrices
+    /// with negative entries, emigration (negative migrants) whose clamp at
+    /// zero could bind, or recorded intervention admissions, the positive
+    /// part of a difference, in a row that can both gain and lose people.
+    /// @param chain The transitions, with their current segment selected.
+    /// @param state_size The dimension of the state.
+    /// @param slots The channel histories of the model; outcomes are only
+    /// accumulated for channels that are recorded.
+    /// @return True if the chain can be fast-forwarded.
+    bool Compose(const std::vector<std::unique_ptr<Transition>> &chain,
+                 Eigen::Index state_size, const HistorySlots &slots);
+
+    /// @brief Estimates whether fast-forwarding beats stepping, once the
+    /// chain has been analyzed or composed.
+    /// @param steps The number of steps to advance in total.
+    /// @param chunk The longest run of steps advanced in one go.
+    /// @return True if the matrix powers are expected to be cheaper.
+    bool IsWorthwhile(int steps, int chunk) const;
+
+    /// @brief Advances the state and adds the outcomes of every step to the
+    /// pending accumulators of the recorded outcome histories.
+    /// @param state The state, replaced by the state `steps` steps later.
+    /// @param steps The number of steps to advance.
+    /// @param slots The channel histories passed to Compose().
+    void Advance(Eigen::VectorXd &state, int steps, const HistorySlots &slots);
+
+    /// @brief Advances like Advance() in closed form, from an
+    /// eigendecomposition of the state block of the composed map. The
+    /// decomposition is computed once per Compose(), after which any number
+    /// of steps costs a few O(n²) products.
+    /// @param state The state, replaced by the state `steps` steps later.
+    /// @param steps The number of steps to advance.
+    /// @param slots The channel histories passed to Compose().
+    /// @return False, leaving the state and histories untouched, if the state
+    /// block is not diagonalizable with well-conditioned eigenvectors.
+    bool AdvanceClosedForm(Eigen::VectorXd &state, int steps,
+                           const HistorySlots &slots);
+
+    /// @brief Solves for the fixed point x = Mx + b of the composed state
+    /// map. If I - M is singular, the fixed point of a chain without inflow
+    /// whose columns conserve the population is taken from the one
+    /// dimensional kernel, scaled to the population of the given state.
+    /// @param state The state the equilibrium keeps the population of.
+    /// @param fixed Receives the fixed point.
+    /// @return False if there is no unique fixed point.
+    bool SolveFixedPoint(const Eigen::VectorXd &state,
+                         Eigen::VectorXd &fixed) const;
+
+private:
+    Eigen::Index _size = 0;
+    // dimension of the augmented matrix, 0 until a chain is analyzed
+    Eigen::Index _dim = 0;
+    // the one-step matrix followed by its repeated squares
+    std::vector<Eigen::MatrixXd> _powers;
+    // recorded outcomes and the offset of their accumulator in the vector
+    std::vector<std::pair<HistoryChannel, Eigen::Index>> _outcomes;
+    // rough flop count of one step executed transition by transition
+    double _step_cost = 0.0;
+    Eigen::VectorXd _augmented;
+    Eigen::VectorXd _scratch;
+    // eigendecomposition of the state block, computed on first use
+    bool _decomposed = false;
+    bool _diagonalizable = false;
+    Eigen::VectorXcd _eigenvalues;
+    Eigen::MatrixXcd _eigenvectors;
+    Eigen::MatrixXcd _inverse_eigenvectors;
+
+    bool Decompose();
+};
+} // namespace respond
+
+#endif // RESPOND_INTERNALS_FAST_FORWARD_HPP_
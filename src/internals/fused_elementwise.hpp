@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: fused_elementwise.hpp                                                //
+// Project: respond                                                           //
+// Created Date: 2026-10-16                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_INTERNALS_FUSED_ELEMENTWISE_HPP_
+#define RESPOND_INTERNALS_FUSED_ELEMENTWISE_HPP_
+
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include <respond/elementwise_kernels.hpp>
+#include <respond/execution_context.hpp>
+#include <respond/transition.hpp>
+
+namespace respond {
+/// @brief Destinations for the outcome contributions of a fused sweep.
+using FusedOutcomes = BlockOutcomes<double>;
+
+/// @brief Transitions whose new value for element i depends only on element
+/// i of the state. Consecutive runs of these are fused by the model into one
+/// sweep over the state.
+class ElementwiseTransition {
+public:
+    virtual ~ElementwiseTransition() = default;
+
+    /// @brief Applies the transition in place to one block of the state.
+    /// Only called on validated transitions, so no checks are performed.
+    /// @param start Index of the first state element held by the block.
+    /// @param block The state elements [start, start + block.size()).
+    /// @param outcomes Accumulators to add this transition's outcomes to.
+    virtual void ApplyBlock(Eigen::Index start,
+                            Eigen::Ref<Eigen::ArrayXd> block,
+                            const FusedOutcomes &outcomes) const = 0;
+};
+
+/// @brief Executes a run of consecutive element-wise transitions as a single
+/// blocked sweep: every block of the state is read once, passed through all
+/// stages while it is cache resident, and written once.
+class FusedElementwise {
+public:
+    /// @brief Number of state elements processed per block.
+    static constexpr Eigen::Index kBlockSize = 256;
+
+    /// @brief Constructs the fused step.
+    /// @param transitions The transitions in execution order.
+    /// @param stages The same transitions viewed as element-wise kernels.
+    FusedElementwise(std::vector<const Transition *> transitions,
+                     std::vector<const ElementwiseTransition *> stages)
+        : _transitions(std::move(transitions)), _stages(std::move(stages)) {}
+
+    /// @brief Runs every stage over the state.
+    /// Falls back to stage-by-stage execution when an outcome history is not
+    /// an accumulated history, since those cannot be written block-wise.
+    /// @param in The current state vector. Must not alias `out`.
+    /// @param out The buffer receiving the resulting state vector.
+    /// @param ctx The execution context of the owning model.
+    void Execute(const Eigen::Ref<const Eigen::VectorXd> &in,
+                 Eigen::VectorXd &out, ExecutionContext &ctx) const;
+
+    /// @brief Number of transitions fused into this step.
+    std::size_t size() const { return _stages.size(); }
+
+private:
+    std::vector<const Transition *> _transitions;
+    std::vector<const ElementwiseTransition *> _stages;
+    // scratch buffer for the stage-by-stage fallback
+    mutable Eigen::VectorXd _fallback;
+};
+} // namespace respond
+
+#endif // RESPOND_INTERNALS_FUSED_ELEMENTWISE_HPP_
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -14,14 +14,22 @@
 
 #include <respond/model.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
-#include <thread>
 #include <vector>
 
 #include <Eigen/Dense>
 
+#include <respond/execution_context.hpp>
 #include <respond/history.hpp>
+#include <respond/history_recorder.hpp>
+#include <respond/logging.hpp>
 #include <respond/transition.hpp>
+#include <respond/typed_pipeline.hpp>
+
+#include "fast_forward.hpp"
+#include "fused_elementwise.hpp"
 
 namespace respond {
 class Markov : public virtual Model {
@@ -29,11 +37,7 @@ public:
     Markov() : Markov("markov", "console") {}
     Markov(const std::string &name, const std::string &log_name)
         : _name(name), _log_name(log_name), _current_timestep(0),
-          _history_capture_interval(1), _final_timestep(-1),
-          _initial_history_recorded(false) {
-        const auto processor_count = std::thread::hardware_concurrency();
-        Eigen::setNbThreads(processor_count);
-    }
+          _initial_history_recorded(false), _finalized(false) {}
 
     // Rule of Five
     ~Markov() = default;
@@ -41,48 +45,92 @@ public:
     // Copy
     std::unique_ptr<Model> clone() const override {
         auto np = Model::Create(GetModelName(), GetLogName());
+        np->SetSubscribedChannels(GetSubscribedChannels());
         np->SetState(GetState());
-        np->SetHistories(GetHistories());
         np->SetHistoryCaptureInterval(GetHistoryCaptureInterval());
         np->SetFinalTimestep(GetFinalTimestep());
-        if (auto *markov = dynamic_cast<Markov *>(np.get())) {
-            markov->_current_timestep = _current_timestep;
-            markov->_initial_history_recorded = _initial_history_recorded;
-        }
         for (const auto &t : GetTransitions()) {
             np->AddTransition(t->clone());
         }
+        auto *markov = dynamic_cast<Markov *>(np.get());
+        if (!markov) {
+            np->SetHistories(GetHistories());
+        } else {
+            // the recorded prefix is immutable, so the copy shares it
+            markov->SetHistories(_histories);
+            markov->_history_prefix = _history_prefix;
+            markov->_current_timestep = _current_timestep;
+            markov->_initial_history_recorded = _initial_history_recorded;
+            markov->_batch_state = _batch_state;
+            markov->_batch_histories = _batch_histories;
+            markov->ResolveBatchSlots();
+            markov->_execution_mode = _execution_mode;
+            markov->_random_key = _random_key;
+            markov->_checkpoints = _checkpoints;
+            markov->_checkpointing = _checkpointing;
+            markov->_next_checkpoint = _next_checkpoint;
+            // the cloned chain was validated together with ours; a static
+            // plan references no transitions, so the copy shares its matrices
+            if (_finalized && _static_plan.size() > 0) {
+                markov->_static_plan = _static_plan;
+                markov->ReserveRun();
+                markov->_finalized = true;
+            } else if (_finalized) {
+                markov->ReserveRun();
+                markov->CompilePlan();
+            }
+        }
         return np;
     }
+    // Moving the records into a shared prefix first makes the branch copy
+    // only the state, the transitions and the histories' pending aggregates.
+    std::unique_ptr<Model> Fork() override {
+        SplitHistoryPrefix();
+        return clone();
+    }
     // Move
-    Markov(Markov &&other) noexcept {
-        _state = other.GetState();
-        _name = other.GetModelName();
-        _log_name = other.GetLogName();
-        for (const auto &t : other.GetTransitions()) {
-            AddTransition(std::move(t));
-        }
-        other.ClearTransitions();
+    Markov(Markov &&other) noexcept
+        : Markov(other._name, other._log_name) {
+        MoveFrom(other);
     }
     Markov &operator=(Markov &&other) noexcept {
         if (this != &other) {
-            _state = other.GetState();
-            _name = other.GetModelName();
-            _log_name = other.GetLogName();
-            for (const auto &t : other.GetTransitions()) {
-                AddTransition(std::move(t));
-            }
-            other.ClearTransitions();
+            MoveFrom(other);
         }
         return *this;
     }
 
-    // anticipate making a copy of the vector
+    // anticipate making a copy of the vector. A finalized plan survives a new
+    // state as long as it keeps the validated shape and stays non-negative.
     void SetState(const Eigen::Ref<const Eigen::VectorXd> &s) override {
+        if (_finalized &&
+            (s.size() != _state.size() || (s.array() < 0).any())) {
+            InvalidatePlan();
+        }
         _state = s;
+        ClearCheckpoints();
+        // a single state ends any batched run
+        _batch_state.resize(0, 0);
+        _batch_histories.clear();
+        _batch_slots.clear();
     }
     // return const & to limit to observation of the state
     Eigen::VectorXd GetState() const override { return _state; }
+
+    // every column starts from a copy of the configured histories
+    void SetBatchState(const Eigen::Ref<const Eigen::MatrixXd> &s) override {
+        SetupHistory();
+        ClearCheckpoints();
+        _batch_state = s;
+        _batch_histories.assign(s.cols(), GetHistories());
+        ResolveBatchSlots();
+    }
+    Eigen::MatrixXd GetBatchState() const override { return _batch_state; }
+    bool IsBatched() const override { return _batch_state.cols() > 0; }
+    std::vector<std::map<std::string, History>>
+    GetBatchHistories() const override {
+        return _batch_histories;
+    }
     // return the transitions
     const std::vector<std::unique_ptr<Transition>> &GetTransitions() const {
         return _transition_vector;
@@ -96,34 +144,360 @@ public:
     ///     5. Background Mortality
     /// @return A vector of the default history objects.
     void CreateDefaultHistories() override {
-        std::map<std::string, History> ret;
-        ret["state"] = History("state", GetLogName(), HistoryMode::Snapshot);
-        ret["total_overdose"] =
-            History("total_overdose", GetLogName(), HistoryMode::Accumulated);
-        ret["fatal_overdose"] =
-            History("fatal_overdose", GetLogName(), HistoryMode::Accumulated);
-        ret["intervention_admission"] = History(
-            "intervention_admission", GetLogName(), HistoryMode::Accumulated);
-        ret["background_death"] =
-            History("background_death", GetLogName(), HistoryMode::Accumulated);
-        SetHistories(ret);
-    }
-
-    // manipulate the state vector
+        SetHistories(HistoryRecorder::DefaultHistories(GetLogName()));
+    }
+
+    // manipulate the state vector. Each transition writes into the scratch
+    // buffer which is then swapped with the state, so once both buffers are
+    // sized a step performs no state allocations.
     void RunTransitions() override {
         SetupHistory();
         if (!_initial_history_recorded) {
             RecordHistoryAtCurrentTimestep();
         }
-        for (const auto &t : _transition_vector) {
-            _state = t->Execute(_state, _histories);
+        if (_checkpointing) {
+            TakeCheckpointIfDue();
+        }
+        for (const auto *t : _scheduled) {
+            t->SelectTimestep(_current_timestep);
+        }
+        if (IsBatched()) {
+            RunBatchTransitions();
+        } else if (_execution_mode == ExecutionMode::kStochastic) {
+            // draws are per transition, so nothing is fused or precompiled
+            ExecutionContext ctx(_histories, _slots, _current_timestep);
+            ctx.random = &_random_key;
+            for (std::size_t i = 0; i < _transition_vector.size(); ++i) {
+                if (!_transition_vector[i]->IsActiveAt(_current_timestep)) {
+                    continue;
+                }
+                ctx.transition = static_cast<int>(i);
+                if (_finalized) {
+                    _transition_vector[i]->ExecuteUnchecked(_state,
+                                                            _next_state, ctx);
+                } else {
+                    _transition_vector[i]->ExecuteInto(_state, _next_state,
+                                                       ctx);
+                }
+                _state.swap(_next_state);
+            }
+        } else if (_finalized && _static_plan.size() > 0) {
+            _static_plan.Run(_state, _next_state, _histories, _slots,
+                             _current_timestep);
+        } else if (_finalized) {
+            ExecutionContext ctx(_histories, _slots, _current_timestep);
+            for (const auto &step : _plan) {
+                if (step.fused) {
+                    step.fused->Execute(_state, _next_state, ctx);
+                } else if (!step.transition->IsActiveAt(_current_timestep)) {
+                    continue;
+                } else {
+                    step.transition->ExecuteUnchecked(_state, _next_state,
+                                                      ctx);
+                }
+                _state.swap(_next_state);
+            }
+        } else {
+            ExecutionContext ctx(_histories, _slots, _current_timestep);
+            for (const auto &t : _transition_vector) {
+                if (!t->IsActiveAt(_current_timestep)) {
+                    continue;
+                }
+                t->ExecuteInto(_state, _next_state, ctx);
+                _state.swap(_next_state);
+            }
         }
         _current_timestep++;
         RecordHistoryAtCurrentTimestep();
     }
-    // assume ownership of the Transition
+
+    // A finalized chain of built-in transitions is the same affine map from
+    // one change time to the next, so each such segment is advanced by
+    // powers of the composed map, stopping at every timestep that records
+    // history. Chains that could clamp fall back to stepping.
+    void RunFor(int steps) override {
+        if (!_finalized || IsBatched() ||
+            _execution_mode == ExecutionMode::kStochastic) {
+            Model::RunFor(steps);
+            return;
+        }
+        SetupHistory();
+        if (!_initial_history_recorded) {
+            RecordHistoryAtCurrentTimestep();
+        }
+        const int end = _current_timestep + steps;
+        while (_current_timestep < end) {
+            if (_checkpointing) {
+                TakeCheckpointIfDue();
+            }
+            const int segment_end =
+                std::min(end, GetNextChangeTime(_current_timestep));
+            for (const auto *t : _scheduled) {
+                t->SelectTimestep(_current_timestep);
+            }
+            const int chunk = std::min(_recorder.GetCaptureInterval(),
+                                       segment_end - _current_timestep);
+            // the cheap analysis rejects a segment before any matrix is
+            // copied or the augmented map is built
+            if (!_fast_forward.Analyze(_transition_vector, _state.size(),
+                                       _slots) ||
+                !_fast_forward.IsWorthwhile(segment_end - _current_timestep,
+                                            chunk) ||
+                !_fast_forward.Compose(_transition_vector, _state.size(),
+                                       _slots)) {
+                while (_current_timestep < segment_end) {
+                    RunTransitions();
+                }
+                continue;
+            }
+            while (_current_timestep < segment_end) {
+                const int stop =
+                    std::min(segment_end,
+                             _recorder.NextRecordTimestep(_current_timestep));
+                _fast_forward.Advance(_state, stop - _current_timestep,
+                                      _slots);
+                _current_timestep = stop;
+                // a record that creates missing histories adds outcomes the
+                // composed map does not accumulate yet
+                const bool complete =
+                    _slots.IsComplete(_recorder.GetSubscribed());
+                RecordHistoryAtCurrentTimestep();
+                if (!complete) {
+                    break;
+                }
+            }
+        }
+    }
+
+    // The change is measured against a copy of the state taken before each
+    // step, one O(n) pass next to the step's matrix products.
+    Convergence RunUntilConverged(int max_steps, double tolerance) override {
+        if (IsBatched()) {
+            return Model::RunUntilConverged(max_steps, tolerance);
+        }
+        Convergence ret;
+        while (ret.steps < max_steps) {
+            _previous_state = _state;
+            RunTransitions();
+            ++ret.steps;
+            ret.change = GetRelativeChange(_previous_state, _state);
+            if (ret.change <= tolerance) {
+                ret.converged = true;
+                break;
+            }
+        }
+        return ret;
+    }
+
+    Eigen::VectorXd SolveEquilibrium() const override {
+        if (!_finalized || IsBatched()) {
+            std::string error_msg =
+                "Markov error: Cannot solve for the equilibrium of model '" +
+                _name + "' unless it is finalized and runs a single scenario";
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        if (GetNextChangeTime(_current_timestep) !=
+            std::numeric_limits<int>::max()) {
+            std::string error_msg =
+                "Markov error: Model '" + _name +
+                "' has change times ahead and no single equilibrium";
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        const auto clones = CloneScheduledChain();
+        const auto &chain = clones.empty() ? _transition_vector : clones;
+        for (const auto &t : clones) {
+            t->SelectTimestep(_current_timestep);
+        }
+        std::map<std::string, History> no_outcomes;
+        HistorySlots slots(no_outcomes);
+        FastForward forward;
+        Eigen::VectorXd equilibrium;
+        if (!forward.Compose(chain, _state.size(), slots) ||
+            !forward.SolveFixedPoint(_state, equilibrium)) {
+            std::string error_msg =
+                "Markov error: Model '" + _name +
+                "' has no unique equilibrium of an affine transition chain";
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        return equilibrium;
+    }
+
+    // Each segment between change times is projected in closed form when its
+    // state block diagonalizes, by matrix powers otherwise, and stepped on a
+    // copy of the state when the chain could clamp. Nothing of the model,
+    // including its histories and the schedule cursors of its transitions,
+    // is modified, so concurrent projections of one model are safe.
+    Projection Project(int steps) const override {
+        if (!_finalized || IsBatched()) {
+            std::string error_msg =
+                "Markov error: Cannot project model '" + _name +
+                "' unless it is finalized and runs a single scenario";
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        std::map<std::string, History> outcomes;
+        for (auto channel : {HistoryChannel::kTotalOverdose,
+                             HistoryChannel::kFatalOverdose,
+                             HistoryChannel::kInterventionAdmission,
+                             HistoryChannel::kBackgroundDeath}) {
+            if (_recorder.GetSubscribed()[static_cast<int>(channel)]) {
+                const auto name = GetHistoryChannelName(channel);
+                outcomes.emplace(name, History(name, GetLogName(),
+                                               HistoryMode::Accumulated));
+            }
+        }
+        HistorySlots slots(outcomes);
+        const auto clones = CloneScheduledChain();
+        const auto &chain = clones.empty() ? _transition_vector : clones;
+        Eigen::VectorXd state = _state;
+        Eigen::VectorXd next;
+        FastForward forward;
+        int timestep = _current_timestep;
+        const int end = timestep + steps;
+        while (timestep < end) {
+            const int segment_end = std::min(end, GetNextChangeTime(timestep));
+            for (const auto &t : clones) {
+                t->SelectTimestep(timestep);
+            }
+            if (!forward.Compose(chain, state.size(), slots)) {
+                for (; timestep < segment_end; ++timestep) {
+                    ExecutionContext ctx(outcomes, slots, timestep);
+                    for (const auto &t : chain) {
+                        if (!t->IsActiveAt(timestep)) {
+                            continue;
+                        }
+                        t->ExecuteUnchecked(state, next, ctx);
+                        state.swap(next);
+                    }
+                }
+                continue;
+            }
+            if (!forward.AdvanceClosedForm(state, segment_end - timestep,
+                                           slots)) {
+                forward.Advance(state, segment_end - timestep, slots);
+            }
+            timestep = segment_end;
+        }
+        Projection ret{state, {}};
+        for (const auto &kv : outcomes) {
+            ret.outcomes[kv.first] =
+                kv.second.HasPendingState()
+                    ? kv.second.GetPendingState()
+                    : Eigen::VectorXd::Zero(state.size()).eval();
+        }
+        return ret;
+    }
+
+    void Finalize() override {
+        InvalidatePlan();
+        SetupHistory();
+        if (_state.size() == 0) {
+            std::string error_msg = "Markov error: Cannot finalize model '" +
+                                    _name + "' before a state is set";
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        if ((_state.array() < 0).any()) {
+            std::string error_msg = "Markov error: Cannot finalize model '" +
+                                    _name + "' with a negative state";
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        for (const auto &t : _transition_vector) {
+            t->ValidateSchedule(_state.size());
+        }
+        if (!HistoriesMatchStateSize(_state.size())) {
+            std::string error_msg =
+                "Markov error: History dimensions of model '" + _name +
+                "' do not match the state size (" +
+                std::to_string(_state.size()) + ")";
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        ReserveRun();
+        CompilePlan();
+    }
+
+    bool IsFinalized() const override { return _finalized; }
+
+    // keep a copy of the Transition
     void AddTransition(const std::unique_ptr<Transition> &t) override {
-        _transition_vector.push_back(t->clone());
+        AddTransition(t->clone());
+    }
+    // assume ownership of the Transition
+    void AddTransition(std::unique_ptr<Transition> &&t) override {
+        _transition_vector.push_back(std::move(t));
+        if (_transition_vector.back()->GetChangeTimes().size() > 1) {
+            _scheduled.push_back(_transition_vector.back().get());
+        }
+        InvalidatePlan();
+        ClearCheckpoints();
+    }
+
+    void SetExecutionMode(ExecutionMode mode,
+                          const RandomKey &key = RandomKey()) override {
+        _execution_mode = mode;
+        _random_key = key;
+        ClearCheckpoints();
+    }
+    ExecutionMode GetExecutionMode() const override {
+        return _execution_mode;
+    }
+
+    void SetCheckpointing(bool enabled) override {
+        _checkpointing = enabled;
+        if (!enabled) {
+            ClearCheckpoints();
+        }
+    }
+
+    // Checkpoints after the change time saw the old transition and are
+    // dropped; the re-run from the restored one takes them again.
+    void ReplaceTransition(std::size_t index, std::unique_ptr<Transition> &&t,
+                           int change_time) override {
+        if (index >= _transition_vector.size()) {
+            std::string error_msg =
+                "Markov error: Model '" + _name + "' has no transition " +
+                std::to_string(index) + " to replace";
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        const int target = _current_timestep;
+        const bool rewind = change_time < target;
+        if (rewind && (_checkpoints.empty() ||
+                       _checkpoints.front().timestep > change_time)) {
+            std::string error_msg =
+                "Markov error: Model '" + _name +
+                "' has no checkpoint at or before timestep " +
+                std::to_string(change_time) + " to resume from";
+            LogError(GetLogName(), error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        const bool finalized = _finalized;
+        _transition_vector[index] = std::move(t);
+        _scheduled.clear();
+        for (const auto &transition : _transition_vector) {
+            if (transition->GetChangeTimes().size() > 1) {
+                _scheduled.push_back(transition.get());
+            }
+        }
+        InvalidatePlan();
+        while (!_checkpoints.empty() &&
+               _checkpoints.back().timestep > change_time) {
+            _checkpoints.pop_back();
+        }
+        if (rewind) {
+            RestoreCheckpoint(_checkpoints.back());
+        }
+        if (finalized) {
+            Finalize();
+        }
+        if (_current_timestep < target) {
+            RunFor(target - _current_timestep);
+        }
     }
     // get the names of each transition we own
     std::vector<std::string> GetTransitionNames() const override {
@@ -134,17 +508,30 @@ public:
         return t_names;
     }
     // delete all the Transition unique_ptrs by clearing the vector
-    void ClearTransitions() override { _transition_vector.clear(); }
+    void ClearTransitions() override {
+        InvalidatePlan();
+        _transition_vector.clear();
+        _scheduled.clear();
+        ClearCheckpoints();
+    }
 
     virtual void
     SetHistories(const std::map<std::string, History> &h) override {
         _histories = h;
+        _history_prefix.clear();
+        ClearCheckpoints();
+        _recorder.DropUnsubscribed(_histories);
+        _slots.Resolve(_histories, _recorder.GetSubscribed());
+        if (_finalized && !HistoriesMatchStateSize(_state.size())) {
+            InvalidatePlan();
+        }
         if (_histories.empty()) {
             ResetHistoryTracking();
             return;
         }
 
-        const int latest_timestep = GetLatestRecordedTimestep();
+        const int latest_timestep =
+            HistoryRecorder::LatestRecordedTimestep(_histories);
         if (latest_timestep < 0) {
             ResetHistoryTracking();
             return;
@@ -155,27 +542,65 @@ public:
     }
     void ClearHistories() override {
         _histories.clear();
+        _history_prefix.clear();
+        ClearCheckpoints();
+        _slots.Resolve(_histories, _recorder.GetSubscribed());
         ResetHistoryTracking();
     }
 
+    void SetSubscribedChannels(
+        const std::vector<HistoryChannel> &channels) override {
+        _recorder.SetSubscribedChannels(channels);
+        _recorder.DropUnsubscribed(_histories);
+        _slots.Resolve(_histories, _recorder.GetSubscribed());
+        ClearCheckpoints();
+        for (auto &histories : _batch_histories) {
+            _recorder.DropUnsubscribed(histories);
+        }
+        ResolveBatchSlots();
+    }
+    std::vector<HistoryChannel> GetSubscribedChannels() const override {
+        return _recorder.GetSubscribedChannels();
+    }
+
     void SetHistoryCaptureInterval(int interval) override {
-        _history_capture_interval = (interval < 1) ? 1 : interval;
+        _recorder.SetCaptureInterval(interval);
+        ClearCheckpoints();
     }
 
     int GetHistoryCaptureInterval() const override {
-        return _history_capture_interval;
+        return _recorder.GetCaptureInterval();
     }
 
     void SetFinalTimestep(int final_timestep) override {
-        _final_timestep = final_timestep;
+        _recorder.SetFinalTimestep(final_timestep);
+        ClearCheckpoints();
     }
 
-    int GetFinalTimestep() const override { return _final_timestep; }
+    int GetFinalTimestep() const override {
+        return _recorder.GetFinalTimestep();
+    }
 
     // return const & to limit to observation of the state. Need copy ability of
     // History, but let that be the History's responsibility
+    // A forked model stitches its shared prefix and its own records.
     std::map<std::string, History> GetHistories() const override {
-        return _histories;
+        if (_history_prefix.empty()) {
+            return _histories;
+        }
+        std::map<std::string, History> ret;
+        for (const auto &kv : _histories) {
+            History stitched = kv.second.WithoutRecords();
+            for (const auto &segment : _history_prefix) {
+                auto found = segment->find(kv.first);
+                if (found != segment->end()) {
+                    stitched.AppendRecords(found->second);
+                }
+            }
+            stitched.AppendRecords(kv.second);
+            ret.emplace(kv.first, std::move(stitched));
+        }
+        return ret;
     }
     // getter for model name
     std::string GetModelName() const override { return _name; }
@@ -183,59 +608,322 @@ public:
 
 private:
     std::vector<std::unique_ptr<Transition>> _transition_vector;
+    // the transitions with change times, which select a segment every step
+    std::vector<const Transition *> _scheduled;
     Eigen::VectorXd _state;
+    // ping-pong partner of _state, only meaningful inside RunTransitions
+    Eigen::VectorXd _next_state;
+    // the state before the last step of RunUntilConverged()
+    Eigen::VectorXd _previous_state;
+    // one scenario per column while batched, with matching histories
+    Eigen::MatrixXd _batch_state;
+    Eigen::MatrixXd _next_batch_state;
+    std::vector<std::map<std::string, History>> _batch_histories;
+    std::vector<HistorySlots> _batch_slots;
     std::string _name;
     std::string _log_name;
     std::map<std::string, History> _histories;
+    // records made before the model was forked, oldest first and shared with
+    // the branches; _histories holds only what was recorded since
+    std::vector<std::shared_ptr<const std::map<std::string, History>>>
+        _history_prefix;
+    // channel histories of _histories, re-resolved whenever the map changes
+    HistorySlots _slots;
+    // channels whose histories are kept, the rest are never computed, and
+    // the timesteps records are taken at
+    HistoryRecorder _recorder;
+    // Where a run can be resumed from: the state and histories at the start
+    // of the run and at each change time since, oldest first. The records
+    // live in shared prefix segments, so a checkpoint copies only the state.
+    struct Checkpoint {
+        int timestep;
+        bool initial_history_recorded;
+        Eigen::VectorXd state;
+        std::vector<std::shared_ptr<const std::map<std::string, History>>>
+            history_prefix;
+        std::map<std::string, History> histories;
+    };
+    std::vector<Checkpoint> _checkpoints;
+    ExecutionMode _execution_mode = ExecutionMode::kExpectedValue;
+    // names the random numbers of a stochastic run
+    RandomKey _random_key;
+    bool _checkpointing = false;
+    // the timestep the next checkpoint is due at
+    int _next_checkpoint = 0;
     int _current_timestep;
-    int _history_capture_interval;
-    int _final_timestep;
     bool _initial_history_recorded;
+    // set by Finalize(), cleared by anything that could break its checks
+    bool _finalized;
+
+    // One entry of the finalized execution plan: a single transition or a
+    // fused run of consecutive element-wise transitions.
+    struct PlanStep {
+        const Transition *transition = nullptr;
+        std::unique_ptr<FusedElementwise> fused;
+    };
+    std::vector<PlanStep> _plan;
+    // A chain made only of built-in transitions is instead compiled into
+    // statically dispatched kernels, so a step makes no virtual calls.
+    TypedPipeline<double> _static_plan;
+    // composed segment map used by RunFor()
+    FastForward _fast_forward;
+
+    // Group the validated chain into plan steps, fusing every run of two or
+    // more element-wise transitions into a single sweep.
+    void CompilePlan() {
+        _plan.clear();
+        _static_plan.Clear();
+        const bool built_in =
+            _scheduled.empty() &&
+            std::all_of(_transition_vector.begin(), _transition_vector.end(),
+                        [](const auto &t) {
+                            return t->GetKind() != TransitionKind::kCustom;
+                        });
+        if (built_in) {
+            _static_plan.Build(_transition_vector);
+            _finalized = true;
+            return;
+        }
+        std::vector<const Transition *> run;
+        std::vector<const ElementwiseTransition *> stages;
+        auto close_run = [&]() {
+            if (run.size() == 1) {
+                _plan.push_back({run.front(), nullptr});
+            } else if (run.size() > 1) {
+                _plan.push_back(
+                    {nullptr, std::make_unique<FusedElementwise>(run, stages)});
+            }
+            run.clear();
+            stages.clear();
+        };
+        for (const auto &t : _transition_vector) {
+            const auto *stage =
+                dynamic_cast<const ElementwiseTransition *>(t.get());
+            if (stage) {
+                run.push_back(t.get());
+                stages.push_back(stage);
+                continue;
+            }
+            close_run();
+            _plan.push_back({t.get(), nullptr});
+        }
+        close_run();
+        _finalized = true;
+    }
+
+    // Batched runs always take the checked kernels; their dimension checks are
+    // negligible next to the matrix-matrix products they guard.
+    void RunBatchTransitions() {
+        BatchExecutionContext ctx(_batch_histories, _batch_slots,
+                                  _current_timestep);
+        if (_execution_mode == ExecutionMode::kStochastic) {
+            ctx.random = &_random_key;
+        }
+        for (std::size_t i = 0; i < _transition_vector.size(); ++i) {
+            if (!_transition_vector[i]->IsActiveAt(_current_timestep)) {
+                continue;
+            }
+            ctx.transition = static_cast<int>(i);
+            _transition_vector[i]->ExecuteBatch(_batch_state,
+                                                _next_batch_state, ctx);
+            _batch_state.swap(_next_batch_state);
+        }
+    }
+
+    // Const queries select schedule segments on clones of the chain, whose
+    // cursors are their own, so they never move the model's. The clones
+    // share the model's matrices. A chain without schedules is not cloned.
+    std::vector<std::unique_ptr<Transition>> CloneScheduledChain() const {
+        std::vector<std::unique_ptr<Transition>> clones;
+        if (!_scheduled.empty()) {
+            for (const auto &t : _transition_vector) {
+                clones.push_back(t->clone());
+            }
+        }
+        return clones;
+    }
+
+    // Size the step buffer and the histories for the run ahead, so a
+    // steady-state step of the finalized model leaves the allocator alone.
+    void ReserveRun() {
+        _next_state.resize(_state.size());
+        const std::size_t records = _recorder.RecordsFrom(_current_timestep);
+        for (auto &kv : _histories) {
+            kv.second.Reserve(records, _state.size());
+        }
+    }
+
+    void InvalidatePlan() {
+        _finalized = false;
+        _plan.clear();
+        _static_plan.Clear();
+    }
+
+    // Take over every buffer of other. Moving the containers keeps the
+    // transitions, history nodes and batch maps at their addresses, so the
+    // scheduled list and the compiled plans stay valid without a rebuild.
+    void MoveFrom(Markov &other) noexcept {
+        _transition_vector = std::move(other._transition_vector);
+        _scheduled = std::move(other._scheduled);
+        _state = std::move(other._state);
+        _next_state = std::move(other._next_state);
+        _previous_state = std::move(other._previous_state);
+        _batch_state = std::move(other._batch_state);
+        _next_batch_state = std::move(other._next_batch_state);
+        _batch_histories = std::move(other._batch_histories);
+        _batch_slots = std::move(other._batch_slots);
+        _name = other._name;
+        _log_name = other._log_name;
+        _histories = std::move(other._histories);
+        _history_prefix = std::move(other._history_prefix);
+        _recorder = other._recorder;
+        _slots.Resolve(_histories, _recorder.GetSubscribed());
+        _execution_mode = other._execution_mode;
+        _random_key = other._random_key;
+        _checkpoints = std::move(other._checkpoints);
+        _checkpointing = other._checkpointing;
+        _next_checkpoint = other._next_checkpoint;
+        _current_timestep = other._current_timestep;
+        _initial_history_recorded = other._initial_history_recorded;
+        _finalized = other._finalized;
+        _plan = std::move(other._plan);
+        _static_plan = std::move(other._static_plan);
+        _fast_forward = std::move(other._fast_forward);
+
+        // leave other empty but usable
+        other._transition_vector.clear();
+        other._scheduled.clear();
+        other._state.resize(0);
+        other._batch_state.resize(0, 0);
+        other._batch_histories.clear();
+        other._batch_slots.clear();
+        other.ClearHistories();
+        other.InvalidatePlan();
+    }
+
+    // Move everything recorded so far into a new shared prefix segment and
+    // continue recording into empty histories.
+    void SplitHistoryPrefix() {
+        std::map<std::string, History> rest;
+        bool recorded = false;
+        for (const auto &kv : _histories) {
+            rest.emplace(kv.first, kv.second.WithoutRecords());
+            recorded = recorded || kv.second.GetLatestRecordedTimestep() >= 0;
+        }
+        if (!recorded) {
+            return;
+        }
+        _history_prefix.push_back(
+            std::make_shared<const std::map<std::string, History>>(
+                std::move(_histories)));
+        _histories = std::move(rest);
+        _slots.Resolve(_histories, _recorder.GetSubscribed());
+        if (_finalized) {
+            ReserveRun();
+        }
+    }
+
+    // The first step of a run and the first step of every schedule segment
+    // start from a checkpoint.
+    void TakeCheckpointIfDue() {
+        if (IsBatched() || _current_timestep < _next_checkpoint) {
+            return;
+        }
+        SplitHistoryPrefix();
+        _checkpoints.push_back({_current_timestep, _initial_history_recorded,
+                                _state, _history_prefix, _histories});
+        _next_checkpoint = GetNextChangeTime(_current_timestep);
+    }
+
+    void RestoreCheckpoint(const Checkpoint &checkpoint) {
+        _current_timestep = checkpoint.timestep;
+        _initial_history_recorded = checkpoint.initial_history_recorded;
+        _state = checkpoint.state;
+        _history_prefix = checkpoint.history_prefix;
+        _histories = checkpoint.histories;
+        _slots.Resolve(_histories, _recorder.GetSubscribed());
+        _next_checkpoint = GetNextChangeTime(_current_timestep);
+    }
+
+    void ClearCheckpoints() {
+        _checkpoints.clear();
+        _next_checkpoint = 0;
+    }
 
     void ResetHistoryTracking() {
         _current_timestep = 0;
         _initial_history_recorded = false;
     }
 
-    int GetLatestRecordedTimestep() const {
-        int latest = -1;
-        for (const auto &kv : _histories) {
-            latest = std::max(latest, kv.second.GetLatestRecordedTimestep());
+    bool HistoriesMatchStateSize(Eigen::Index size) const {
+        for (const auto &segment : _history_prefix) {
+            if (!HistoriesMatchStateSize(*segment, size)) {
+                return false;
+            }
         }
-        return latest;
+        return HistoriesMatchStateSize(_histories, size);
     }
 
-    bool ShouldRecordHistoryAtTimestep(int timestep) const {
-        if (timestep == 0) {
-            return true;
+    static bool
+    HistoriesMatchStateSize(const std::map<std::string, History> &histories,
+                            Eigen::Index size) {
+        for (const auto &kv : histories) {
+            for (const auto &s : kv.second.GetRecordedStates()) {
+                if (s.size() != size) {
+                    return false;
+                }
+            }
+            if (kv.second.HasPendingState() &&
+                kv.second.GetPendingState().size() != size) {
+                return false;
+            }
         }
-        if (_final_timestep >= 0 && timestep == _final_timestep) {
-            return true;
+        return true;
+    }
+
+    // the first change time of any scheduled transition after a timestep
+    int GetNextChangeTime(int timestep) const {
+        int next = std::numeric_limits<int>::max();
+        for (const auto *t : _scheduled) {
+            for (int change_time : t->GetChangeTimes()) {
+                if (change_time > timestep) {
+                    next = std::min(next, change_time);
+                    break;
+                }
+            }
         }
-        return timestep % _history_capture_interval == 0;
+        return next;
     }
 
     void RecordHistoryAtCurrentTimestep() {
         if (_initial_history_recorded && _current_timestep == 0) {
             return;
         }
-        if (!ShouldRecordHistoryAtTimestep(_current_timestep)) {
+        if (!_recorder.ShouldRecord(_current_timestep)) {
             return;
         }
 
-        _histories["state"].RecordSnapshot(_state, _current_timestep);
-        const auto size = _state.size();
-        _histories["intervention_admission"].FlushPendingState(
-            _current_timestep, size);
-        _histories["total_overdose"].FlushPendingState(_current_timestep, size);
-        _histories["fatal_overdose"].FlushPendingState(_current_timestep, size);
-        _histories["background_death"].FlushPendingState(_current_timestep,
-                                                         size);
+        if (IsBatched()) {
+            for (Eigen::Index k = 0; k < _batch_state.cols(); ++k) {
+                _recorder.Record(_batch_histories[k], _batch_slots[k],
+                                 _batch_state.col(k), _current_timestep);
+            }
+        } else {
+            _recorder.Record(_histories, _slots, _state, _current_timestep);
+        }
         _initial_history_recorded = true;
     }
 
+    void ResolveBatchSlots() {
+        _batch_slots.clear();
+        for (auto &histories : _batch_histories) {
+            _batch_slots.emplace_back(histories, _recorder.GetSubscribed());
+        }
+    }
+
+    // with no channel subscribed there is nothing to default to
     void SetupHistory() {
-        if (_histories.empty()) {
+        if (_histories.empty() && _recorder.GetSubscribed().any()) {
             CreateDefaultHistories();
         }
     }
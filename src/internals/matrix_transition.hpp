@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: matrix_transition.hpp                                                //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_INTERNALS_MATRIX_TRANSITION_HPP_
+#define RESPOND_INTERNALS_MATRIX_TRANSITION_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <respond/random.hpp>
+
+#include "schedule.hpp"
+#include "transition_base.hpp"
+
+namespace respond {
+/// @brief A transition operator stored either densely or in compressed
+/// sparse form, applied to a state vector or a batch of state columns.
+class LinearOperator {
+public:
+    /// @brief Dense matrices with at most this fraction of non-zero entries
+    /// are stored and applied in sparse form.
+    static constexpr double kSparseDensityThreshold = 0.1;
+
+    /// @brief Stores a dense matrix, converting it to sparse form if its
+    /// density is at or below kSparseDensityThreshold.
+    explicit LinearOperator(const Eigen::Ref<const Eigen::MatrixXd> &m) {
+        const auto non_zeros = (m.array() != 0.0).count();
+        if (m.size() > 0 && static_cast<double>(non_zeros) <=
+                                kSparseDensityThreshold * m.size()) {
+            _sparse = m.sparseView();
+            _sparse.makeCompressed();
+            _is_sparse = true;
+        } else {
+            _dense = m;
+        }
+    }
+
+    /// @brief Stores a sparse matrix as is.
+    explicit LinearOperator(const Eigen::SparseMatrix<double> &m)
+        : _sparse(m), _is_sparse(true) {
+        _sparse.makeCompressed();
+    }
+
+    Eigen::Index rows() const {
+        return _is_sparse ? _sparse.rows() : _dense.rows();
+    }
+    Eigen::Index cols() const {
+        return _is_sparse ? _sparse.cols() : _dense.cols();
+    }
+    bool IsSparse() const { return _is_sparse; }
+
+    /// @brief Materializes the operator as a dense matrix.
+    Eigen::MatrixXd ToDense() const {
+        return _is_sparse ? Eigen::MatrixXd(_sparse) : _dense;
+    }
+
+    /// @brief Computes out = operator * rhs without temporaries.
+    /// @param rhs A state vector or a matrix of state columns. Must not alias
+    /// `out`.
+    /// @param out The destination, resized to match the product.
+    template <typename Rhs, typename Dest>
+    void Apply(const Rhs &rhs, Dest &out) const {
+        if (_is_sparse) {
+            out.noalias() = _sparse * rhs;
+        } else {
+            out.noalias() = _dense * rhs;
+        }
+    }
+
+    /// @brief Moves the whole part of each source state (column) with one
+    /// multinomial draw, made as conditional binomial draws down the column;
+    /// the fractional part stays where it is. Whatever a column sums to less
+    /// than one leaves the population. Each column draws from its own stream
+    /// and in row order, so dense and sparse storage give the same
+    /// realization.
+    /// @param state The current state. Must not alias `out`.
+    /// @param out The destination, resized to the number of rows.
+    /// @param key The key of the stochastic run.
+    /// @param timestep The timestep being executed.
+    /// @param transition The position of the transition in the chain.
+    /// @return False if a column with people to move sums to more than one.
+    bool Sample(const Eigen::Ref<const Eigen::VectorXd> &state,
+                Eigen::VectorXd &out, const RandomKey &key, int timestep,
+                int transition) const {
+        constexpr double kTolerance = 1e-9;
+        out.setZero(rows());
+        if (!_is_sparse) {
+            for (Eigen::Index j = 0; j < cols(); ++j) {
+                double people = std::floor(state(j));
+                double mass = 1.0;
+                if (j < rows()) {
+                    out(j) += state(j) - people;
+                }
+                auto stream = key.Stream(timestep, transition, j);
+                for (Eigen::Index i = 0; i < rows() && people > 0.0; ++i) {
+                    const double p = _dense(i, j);
+                    if (p <= 0.0) {
+                        continue;
+                    }
+                    if (p > mass + kTolerance) {
+                        return false;
+                    }
+                    const double moved =
+                        SampleBinomial(people, p / mass, stream);
+                    out(i) += moved;
+                    people -= moved;
+                    mass -= p;
+                }
+            }
+            return true;
+        }
+        // rows come outermost, so every column keeps its own draw state
+        Eigen::ArrayXd people = state.array().floor();
+        Eigen::ArrayXd mass = Eigen::ArrayXd::Ones(cols());
+        const Eigen::Index kept = std::min(rows(), cols());
+        out.head(kept) += (state.array() - people).matrix().head(kept);
+        std::vector<RandomStream> streams;
+        streams.reserve(cols());
+        for (Eigen::Index j = 0; j < cols(); ++j) {
+            streams.push_back(key.Stream(timestep, transition, j));
+        }
+        for (Eigen::Index i = 0; i < _sparse.outerSize(); ++i) {
+            for (decltype(_sparse)::InnerIterator it(_sparse, i); it; ++it) {
+                const Eigen::Index j = it.col();
+                const double p = it.value();
+                if (p <= 0.0 || people(j) <= 0.0) {
+                    continue;
+                }
+                if (p > mass(j) + kTolerance) {
+                    return false;
+                }
+                const double moved =
+                    SampleBinomial(people(j), p / mass(j), streams[j]);
+                out(i) += moved;
+                people(j) -= moved;
+                mass(j) -= p;
+            }
+        }
+        return true;
+    }
+
+private:
+    Eigen::MatrixXd _dense;
+    // row-major so each output element is one contiguous dot product
+    Eigen::SparseMatrix<double, Eigen::RowMajor> _sparse;
+    bool _is_sparse = false;
+};
+
+/// @brief Base for transitions that multiply the state by a full operator.
+/// Operators are kept as LinearOperator instead of dense matrices so that
+/// mostly-zero behavior and intervention matrices are stored and applied in
+/// sparse form.
+class MatrixTransition : public virtual TransitionBase {
+public:
+    MatrixTransition(const std::string &name, const std::string &log_name)
+        : TransitionBase(name, log_name) {}
+
+    // Dense matrices below the density threshold are converted on insertion.
+    void
+    AddTransitionMatrix(const Eigen::Ref<const Eigen::MatrixXd> &m) override {
+        _operators.Add(LinearOperator(m));
+    }
+    void
+    AddSparseTransitionMatrix(const Eigen::SparseMatrix<double> &m) override {
+        _operators.Add(LinearOperator(m));
+    }
+    void ClearTransitionMatrices() override { _operators.Clear(); }
+
+    void AddChangeTime(int change_time) override {
+        if (!_operators.AddChangeTime(change_time)) {
+            ThrowInvalidChangeTime(change_time);
+        }
+    }
+    std::vector<int> GetChangeTimes() const override {
+        return _operators.GetChangeTimes();
+    }
+    void SelectTimestep(int timestep) const override {
+        _operators.Select(timestep);
+    }
+
+    std::vector<Eigen::MatrixXd> CopyTransitionMatrices() const override {
+        std::vector<Eigen::MatrixXd> ret;
+        for (const auto &op : _operators.Active()) {
+            ret.push_back(op.ToDense());
+        }
+        return ret;
+    }
+
+protected:
+    // The operators of the segment selected by SelectTimestep().
+    const std::vector<LinearOperator> &GetOperators() const {
+        return _operators.Active();
+    }
+    // used by clone() so sparse operators are not densified on the way
+    void CopyOperatorsTo(MatrixTransition &other) const {
+        other._operators = _operators;
+    }
+
+private:
+    Schedule<LinearOperator> _operators;
+};
+} // namespace respond
+
+#endif // RESPOND_INTERNALS_MATRIX_TRANSITION_HPP_
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: schedule.hpp                                                         //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RESPOND_INTERNALS_SCHEDULE_HPP_
+#define RESPOND_INTERNALS_SCHEDULE_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace respond {
+/// @brief A sequence of value sets keyed by the timestep they take effect at.
+/// The first segment starts at timestep 0 and each later one replaces its
+/// predecessor from its change time on. A cursor tracks the active segment
+/// and moves forward one segment at a time as the timestep advances, so
+/// selecting the values for consecutive timesteps is O(1) and copies
+/// nothing.
+/// Copies share the values until one of them is modified, so cloning a
+/// transition does not copy its matrices; only the cursor is per copy.
+template <typename T> class Schedule {
+public:
+    Schedule() : _segments(std::make_shared<Segments>(1)), _active(0) {}
+
+    /// @brief Appends a value to the last segment.
+    /// @param value The value to append.
+    void Add(T value) {
+        Mutable().back().values.push_back(std::move(value));
+    }
+
+    /// @brief Starts a new, empty segment at a change time.
+    /// @param change_time The timestep the segment takes effect at.
+    /// @return False if the change time does not come after the last one.
+    bool AddChangeTime(int change_time) {
+        if (change_time <= _segments->back().change_time) {
+            return false;
+        }
+        Mutable().push_back({change_time, {}});
+        return true;
+    }
+
+    /// @brief Retrieves the timesteps each segment takes effect at.
+    /// @return The change times in increasing order, starting with 0.
+    std::vector<int> GetChangeTimes() const {
+        std::vector<int> ret;
+        for (const auto &s : *_segments) {
+            ret.push_back(s.change_time);
+        }
+        return ret;
+    }
+
+    /// @brief Indicates whether the schedule has more than one segment.
+    bool IsScheduled() const { return _segments->size() > 1; }
+
+    /// @brief Moves the cursor to the segment in effect at a timestep.
+    /// Advancing by one timestep moves at most one segment; going back in
+    /// time restarts from the first segment.
+    /// @param timestep The timestep to select.
+    void Select(int timestep) const {
+        const auto &segments = *_segments;
+        if (timestep < segments[_active].change_time) {
+            _active = 0;
+        }
+        while (_active + 1 < segments.size() &&
+               segments[_active + 1].change_time <= timestep) {
+            ++_active;
+        }
+    }
+
+    /// @brief Retrieves the values of the active segment.
+    const std::vector<T> &Active() const {
+        return (*_segments)[_active].values;
+    }
+
+    /// @brief Removes every value and change time.
+    void Clear() {
+        _segments = std::make_shared<Segments>(1);
+        _active = 0;
+    }
+
+private:
+    struct Segment {
+        int change_time = 0;
+        std::vector<T> values;
+    };
+    using Segments = std::vector<Segment>;
+    // shared with copies; never modified while shared
+    std::shared_ptr<Segments> _segments;
+    // the cursor only selects, so moving it is not a logical modification
+    mutable std::size_t _active;
+
+    // copies the values first if another schedule still shares them
+    Segments &Mutable() {
+        if (_segments.use_count() > 1) {
+            _segments = std::make_shared<Segments>(*_segments);
+        }
+        return *_segments;
+    }
+};
+} // namespace respond
+
+#endif // RESPOND_INTERNALS_SCHEDULE_HPP_
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -14,6 +14,14 @@
 
 #include <respond/transition.hpp>
 
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <respond/logging.hpp>
+
+#include "schedule.hpp"
+
 namespace respond {
 
 class TransitionBase : public virtual Transition {
@@ -21,30 +29,72 @@ public:
     TransitionBase(const std::string &name, const std::string &log_name)
         : _name(name), _log_name(log_name) {}
     virtual ~TransitionBase() = default;
+    // Allocating execution is implemented on top of ExecuteInto so concrete
+    // transitions only have to provide the in-place kernel.
+    Eigen::VectorXd Execute(const Eigen::Ref<const Eigen::VectorXd> &s,
+                            std::map<std::string, History> &h) const override {
+        Eigen::VectorXd out;
+        ExecutionContext ctx(h);
+        ExecuteInto(s, out, ctx);
+        return out;
+    }
+    // Concrete transitions write their result into the caller's buffer.
+    void ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                     Eigen::VectorXd &out,
+                     ExecutionContext &ctx) const override = 0;
     // Add a Transition Matrix to the set. We have no need to edit it once it's
     // been added, just use it. Thus, we don't need full ownership (reference)
     // and can accept the const type.
     void
     AddTransitionMatrix(const Eigen::Ref<const Eigen::MatrixXd> &m) override {
-        _transition_matrices.push_back(m);
+        _transition_matrices.Add(m);
+    }
+    // Matrices added from here on form the segment starting at change_time.
+    void AddChangeTime(int change_time) override {
+        if (!_transition_matrices.AddChangeTime(change_time)) {
+            ThrowInvalidChangeTime(change_time);
+        }
+    }
+    std::vector<int> GetChangeTimes() const override {
+        return _transition_matrices.GetChangeTimes();
+    }
+    void SelectTimestep(int timestep) const override {
+        _transition_matrices.Select(timestep);
     }
     // Get the name of the Transition. No need to edit the object and do not
     // need user to edit the name.
     std::string GetTransitionName() const override { return _name; }
     // Clear out all the stored Eigen::MatrixXd values
-    void ClearTransitionMatrices() override { _transition_matrices.clear(); }
+    void ClearTransitionMatrices() override { _transition_matrices.Clear(); }
 
     std::string GetLogName() const override { return _log_name; }
 
+    std::vector<Eigen::MatrixXd> CopyTransitionMatrices() const override {
+        return _transition_matrices.Active();
+    }
+
 protected:
+    // The matrices of the segment selected by SelectTimestep().
     const std::vector<Eigen::MatrixXd> &GetTransitionMatrices() const {
-        return _transition_matrices;
+        return _transition_matrices.Active();
+    }
+    // used by clone() so every segment of the schedule is copied
+    void CopyTransitionMatricesTo(TransitionBase &other) const {
+        other._transition_matrices = _transition_matrices;
+    }
+    [[noreturn]] void ThrowInvalidChangeTime(int change_time) const {
+        std::string error_msg =
+            "Transition error: Change time " + std::to_string(change_time) +
+            " of transition '" + _name +
+            "' does not come after the previous change time";
+        LogError(_log_name, error_msg);
+        throw std::runtime_error(error_msg);
     }
 
 private:
     std::string _name;
     std::string _log_name;
-    std::vector<Eigen::MatrixXd> _transition_matrices;
+    Schedule<Eigen::MatrixXd> _transition_matrices;
 };
 
 } // namespace respond
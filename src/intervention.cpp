@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -19,39 +19,80 @@
 #include <spdlog/spdlog.h>
 
 namespace respond {
-Eigen::VectorXd
-Intervention::Execute(const Eigen::Ref<const Eigen::VectorXd> &state,
-                      std::map<std::string, History> &h) const {
-    if (GetTransitionMatrices().size() != 1) {
+void Intervention::ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &state,
+                               Eigen::VectorXd &out,
+                               ExecutionContext &ctx) const {
+    Validate(state.rows());
+    ExecuteUnchecked(state, out, ctx);
+}
+
+void Intervention::Validate(Eigen::Index state_size) const {
+    if (GetOperators().size() != 1) {
         std::string error_msg =
             "Intervention error: Expected 1 transition matrix, got " +
-            std::to_string(GetTransitionMatrices().size());
+            std::to_string(GetOperators().size());
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-
-    Eigen::VectorXd zero_matrix = Eigen::VectorXd::Zero(state.size());
-    if (state.rows() != GetTransitionMatrices()[0].cols()) {
+    if (state_size != GetOperators()[0].rows() ||
+        state_size != GetOperators()[0].cols()) {
         std::stringstream ss;
         ss << "Intervention error: State dimension mismatch. State size is ("
-           << state.rows() << ", " << state.cols()
-           << ") but transition matrix expects ("
-           << GetTransitionMatrices()[0].rows() << ", "
-           << GetTransitionMatrices()[0].cols() << ")";
+           << state_size << ", 1) but transition matrix expects ("
+           << GetOperators()[0].rows() << ", "
+           << GetOperators()[0].cols() << ")";
         std::string error_msg = ss.str();
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-    auto moved = GetTransitionMatrices()[0] * state;
+}
+
+void Intervention::ExecuteUnchecked(
+    const Eigen::Ref<const Eigen::VectorXd> &state, Eigen::VectorXd &out,
+    ExecutionContext &ctx) const {
+    if (ctx.random) {
+        SampleInto(state, out, ctx);
+    } else {
+        GetOperators()[0].Apply(state, out);
+    }
 
     // Add intervention_admissions to history if avaliable
-    Eigen::VectorXd admissions = moved - state;
-    admissions = admissions.cwiseMax(Eigen::VectorXd::Zero(admissions.size()));
-    if (h.find("intervention_admission") != h.end()) {
-        h["intervention_admission"].AccumulateState(admissions);
+    if (auto *admissions =
+            ctx.slots[HistoryChannel::kInterventionAdmission]) {
+        admissions->AccumulateState((out - state).cwiseMax(0.0));
+    }
+}
+
+void Intervention::ExecuteBatch(
+    const Eigen::Ref<const Eigen::MatrixXd> &states, Eigen::MatrixXd &out,
+    BatchExecutionContext &ctx) const {
+    Validate(states.rows());
+    if (ctx.random) {
+        Transition::ExecuteBatch(states, out, ctx);
+        return;
+    }
+    GetOperators()[0].Apply(states, out);
+
+    for (Eigen::Index k = 0; k < states.cols(); ++k) {
+        if (auto *admissions =
+                ctx.slots[k][HistoryChannel::kInterventionAdmission]) {
+            admissions->AccumulateState(
+                (out.col(k) - states.col(k)).cwiseMax(0.0));
+        }
     }
+}
 
-    return moved;
+void Intervention::SampleInto(const Eigen::Ref<const Eigen::VectorXd> &state,
+                              Eigen::VectorXd &out,
+                              ExecutionContext &ctx) const {
+    if (!GetOperators()[0].Sample(state, out, *ctx.random, ctx.timestep,
+                                  ctx.transition)) {
+        std::string error_msg =
+            "Intervention error: A column of the transition matrix sums to "
+            "more than 1, which a stochastic run cannot sample";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
 }
 
 std::unique_ptr<Transition> Intervention::Create(const std::string &name,
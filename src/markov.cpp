@@ -15,6 +15,7 @@
 #include <memory>
 #include <string>
 
+#include <respond/compiled_model.hpp>
 #include <respond/logging.hpp>
 #include <respond/model.hpp>
 
@@ -24,4 +25,13 @@ std::unique_ptr<Model> Model::Create(const std::string &name,
                                      const std::string &log_name) {
     return std::make_unique<Markov>(name, log_name);
 }
+
+std::unique_ptr<Model> Model::Create(const std::string &name,
+                                     const std::string &log_name,
+                                     Precision precision) {
+    if (precision == Precision::kSingle) {
+        return std::make_unique<CompiledModel<float>>(name, log_name);
+    }
+    return Create(name, log_name);
+}
 } // namespace respond
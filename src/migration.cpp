@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -19,9 +19,13 @@
 #include <spdlog/spdlog.h>
 
 namespace respond {
-Eigen::VectorXd
-Migration::Execute(const Eigen::Ref<const Eigen::VectorXd> &state,
-                   std::map<std::string, History> &h) const {
+void Migration::ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &state,
+                            Eigen::VectorXd &out, ExecutionContext &ctx) const {
+    Validate(state.size());
+    ExecuteUnchecked(state, out, ctx);
+}
+
+void Migration::Validate(Eigen::Index state_size) const {
     if (GetTransitionMatrices().size() != 1) {
         std::string error_msg =
             "Migration error: Expected 1 transition matrix, got " +
@@ -29,18 +33,39 @@ Migration::Execute(const Eigen::Ref<const Eigen::VectorXd> &state,
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-    if (state.size() != GetTransitionMatrices()[0].size()) {
+    if (state_size != GetTransitionMatrices()[0].size()) {
         std::string error_msg =
-            "Migration error: State size (" + std::to_string(state.size()) +
+            "Migration error: State size (" + std::to_string(state_size) +
             ") does not match transition matrix size (" +
             std::to_string(GetTransitionMatrices()[0].size()) + ")";
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-    auto subtracted = state + GetTransitionMatrices()[0];
-    auto zero_stop = subtracted.array().max(
-        Eigen::VectorXd::Zero(subtracted.size()).array());
-    return zero_stop;
+}
+
+void Migration::ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &state,
+                                 Eigen::VectorXd &out,
+                                 ExecutionContext &) const {
+    out = state;
+    MigrationKernel(out.array(), GetTransitionMatrices()[0].col(0).array());
+}
+
+void Migration::ExecuteBatch(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                             Eigen::MatrixXd &out,
+                             BatchExecutionContext &) const {
+    Validate(states.rows());
+    out = states;
+    for (Eigen::Index k = 0; k < states.cols(); ++k) {
+        MigrationKernel(out.col(k).array(),
+                        GetTransitionMatrices()[0].col(0).array());
+    }
+}
+
+void Migration::ApplyBlock(Eigen::Index start, Eigen::Ref<Eigen::ArrayXd> block,
+                           const FusedOutcomes &) const {
+    MigrationKernel(
+        block,
+        GetTransitionMatrices()[0].col(0).segment(start, block.size()).array());
 }
 
 std::unique_ptr<Transition> Migration::Create(const std::string &name,
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -19,9 +19,118 @@
 #include <spdlog/spdlog.h>
 
 namespace respond {
-Eigen::VectorXd
-Overdose::Execute(const Eigen::Ref<const Eigen::VectorXd> &state,
-                  std::map<std::string, History> &h) const {
+void Overdose::ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &state,
+                           Eigen::VectorXd &out, ExecutionContext &ctx) const {
+    CheckDimensions(state.size());
+    auto fods = state.cwiseProduct(GetTransitionMatrices()[0])
+                    .cwiseProduct(GetTransitionMatrices()[1]);
+    if (!(state.array() >= fods.array()).all()) {
+        std::string error_msg =
+            "Overdose error: State values are less than estimated fatal "
+            "overdoses. " +
+            std::to_string((state.array() < fods.array()).count()) +
+            " elements affected";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    ExecuteUnchecked(state, out, ctx);
+}
+
+void Overdose::Validate(Eigen::Index state_size) const {
+    CheckDimensions(state_size);
+    // With non-negative populations the fatal overdoses can only exceed the
+    // state if the combined probability does, so checking the rates once
+    // replaces the per-step comparison against the state.
+    const auto fatal_rate = GetTransitionMatrices()[0].cwiseProduct(
+        GetTransitionMatrices()[1]);
+    if ((fatal_rate.array() > 1.0).any()) {
+        std::string error_msg =
+            "Overdose error: Overdose and fatality probabilities combine to "
+            "more than 1 for " +
+            std::to_string((fatal_rate.array() > 1.0).count()) + " elements";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+}
+
+void Overdose::ExecuteUnchecked(const Eigen::Ref<const Eigen::VectorXd> &state,
+                                Eigen::VectorXd &out,
+                                ExecutionContext &ctx) const {
+    if (ctx.random) {
+        SampleInto(state, out, ctx);
+        return;
+    }
+    out = state;
+    OverdoseKernel(out.array(), GetTransitionMatrices()[0].col(0).array(),
+                   GetTransitionMatrices()[1].col(0).array(),
+                   HistorySink(ctx.slots[HistoryChannel::kTotalOverdose]),
+                   HistorySink(ctx.slots[HistoryChannel::kFatalOverdose]));
+}
+
+void Overdose::ExecuteBatch(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                            Eigen::MatrixXd &out,
+                            BatchExecutionContext &ctx) const {
+    CheckDimensions(states.rows());
+    if (ctx.random) {
+        Transition::ExecuteBatch(states, out, ctx);
+        return;
+    }
+    // broadcast the per-element probabilities across every scenario column
+    auto overdoses =
+        states.array().colwise() * GetTransitionMatrices()[0].col(0).array();
+    auto fods = overdoses.colwise() * GetTransitionMatrices()[1].col(0).array();
+    if (!(states.array() >= fods).all()) {
+        std::string error_msg =
+            "Overdose error: State values are less than estimated fatal "
+            "overdoses. " +
+            std::to_string((states.array() < fods).count()) +
+            " elements affected";
+        LogError(GetLogName(), error_msg);
+        throw std::runtime_error(error_msg);
+    }
+    out = states;
+    for (Eigen::Index k = 0; k < states.cols(); ++k) {
+        const auto &slots = ctx.slots[k];
+        OverdoseKernel(out.col(k).array(),
+                       GetTransitionMatrices()[0].col(0).array(),
+                       GetTransitionMatrices()[1].col(0).array(),
+                       HistorySink(slots[HistoryChannel::kTotalOverdose]),
+                       HistorySink(slots[HistoryChannel::kFatalOverdose]));
+    }
+}
+
+void Overdose::ApplyBlock(Eigen::Index start, Eigen::Ref<Eigen::ArrayXd> block,
+                          const FusedOutcomes &outcomes) const {
+    const Eigen::Index length = block.size();
+    OverdoseKernel(
+        block, GetTransitionMatrices()[0].col(0).segment(start, length).array(),
+        GetTransitionMatrices()[1].col(0).segment(start, length).array(),
+        AccumulatorSink(outcomes.total_overdose, start),
+        AccumulatorSink(outcomes.fatal_overdose, start));
+}
+
+void Overdose::SampleInto(const Eigen::Ref<const Eigen::VectorXd> &state,
+                          Eigen::VectorXd &out, ExecutionContext &ctx) const {
+    const auto &overdose = GetTransitionMatrices()[0];
+    const auto &fatality = GetTransitionMatrices()[1];
+    Eigen::VectorXd overdoses(state.size());
+    Eigen::VectorXd fods(state.size());
+    for (Eigen::Index i = 0; i < state.size(); ++i) {
+        // the fatal overdoses are drawn among the overdoses, from one stream
+        auto stream = ctx.random->Stream(ctx.timestep, ctx.transition, i);
+        overdoses(i) = SampleBinomial(state(i), overdose(i), stream);
+        fods(i) = SampleBinomial(overdoses(i), fatality(i), stream);
+    }
+    if (auto *total = ctx.slots[HistoryChannel::kTotalOverdose]) {
+        total->AccumulateState(overdoses);
+    }
+    if (auto *fatal = ctx.slots[HistoryChannel::kFatalOverdose]) {
+        fatal->AccumulateState(fods);
+    }
+    out = state - fods;
+}
+
+void Overdose::CheckDimensions(Eigen::Index state_size) const {
     if (GetTransitionMatrices().size() != 2) {
         std::string error_msg =
             "Overdose error: Expected 2 transition matrices, got " +
@@ -30,45 +139,24 @@ Overdose::Execute(const Eigen::Ref<const Eigen::VectorXd> &state,
         throw std::runtime_error(error_msg);
     }
 
-    if (state.size() != GetTransitionMatrices()[0].size()) {
+    if (state_size != GetTransitionMatrices()[0].size()) {
         std::string error_msg =
-            "Overdose error: State size (" + std::to_string(state.size()) +
+            "Overdose error: State size (" + std::to_string(state_size) +
             ") does not match transition matrix size (" +
             std::to_string(GetTransitionMatrices()[0].size()) + ")";
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-    Eigen::VectorXd overdoses =
-        state.cwiseProduct(GetTransitionMatrices()[0]); // overdose
-    // Add total overdoses to stamp
-    if (h.find("total_overdose") != h.end()) {
-        h["total_overdose"].AccumulateState(overdoses);
-    }
 
-    if (overdoses.size() != GetTransitionMatrices()[1].size()) {
+    if (state_size != GetTransitionMatrices()[1].size()) {
         std::string error_msg =
             "Overdose error: Fatal overdose vector size (" +
-            std::to_string(overdoses.size()) +
+            std::to_string(state_size) +
             ") does not match transition matrix size (" +
             std::to_string(GetTransitionMatrices()[1].size()) + ")";
         LogError(GetLogName(), error_msg);
         throw std::runtime_error(error_msg);
     }
-    auto fods = overdoses.cwiseProduct(GetTransitionMatrices()[1]); // negatives
-    if (h.find("fatal_overdose") != h.end()) {
-        h["fatal_overdose"].AccumulateState(fods);
-    }
-    if (!(state.array() >= fods.array()).all()) {
-        std::string error_msg =
-            "Overdose error: State values are less than estimated fatal "
-            "overdoses. " +
-            std::to_string((state.array() < fods.array()).count()) +
-            " elements affected";
-        LogError(GetLogName(), error_msg);
-        throw std::runtime_error(error_msg);
-    }
-    auto new_state = state - fods; // remove fods from state
-    return new_state;
 }
 
 std::unique_ptr<Transition> Overdose::Create(const std::string &name,
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: random.cpp                                                           //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <respond/random.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace respond {
+namespace {
+// Below this mean inversion needs fewer uniforms than rejection.
+constexpr double kInversionMean = 10.0;
+
+// Sums geometric waiting times until they pass the trials; the number of
+// whole waits is binomial. Costs about trials * probability + 1 uniforms.
+double SampleByInversion(double trials, double probability,
+                         RandomStream &stream) {
+    const double log_failure = std::log1p(-probability);
+    double waited = 0.0;
+    double successes = 0.0;
+    while (true) {
+        waited += std::ceil(std::log(stream.Uniform()) / log_failure);
+        if (waited > trials) {
+            return successes;
+        }
+        successes += 1.0;
+    }
+}
+
+// The tail of Stirling's series, log(k!) - log(sqrt(2 pi) (k + 1)^(k + 1/2)
+// e^-(k + 1)), tabulated for small k.
+double StirlingTail(double k) {
+    static constexpr double kTail[] = {
+        0.0810614667953272,  0.0413406959554092,  0.0276779256849983,
+        0.02079067210376509, 0.0166446911898211,  0.0138761288230707,
+        0.0118967099458917,  0.0104112652619720,  0.00925546218271273,
+        0.00833056343336287};
+    if (k <= 9.0) {
+        return kTail[static_cast<int>(k)];
+    }
+    const double squared = (k + 1.0) * (k + 1.0);
+    return (1.0 / 12.0 - (1.0 / 360.0 - 1.0 / 1260.0 / squared) / squared) /
+           (k + 1.0);
+}
+
+// Hörmann (1993), "The generation of binomial random variates", algorithm
+// BTRS. Accepts about 80% of candidates for large means; needs
+// probability <= 0.5 and trials * probability >= 10.
+double SampleByRejection(double trials, double probability,
+                         RandomStream &stream) {
+    const double spread =
+        std::sqrt(trials * probability * (1.0 - probability));
+    const double b = 1.15 + 2.53 * spread;
+    const double a = -0.0873 + 0.0248 * b + 0.01 * probability;
+    const double c = trials * probability + 0.5;
+    const double v_r = 0.92 - 4.2 / b;
+    const double r = probability / (1.0 - probability);
+    const double alpha = (2.83 + 5.1 / b) * spread;
+    const double mode = std::floor((trials + 1.0) * probability);
+    while (true) {
+        const double u = stream.Uniform() - 0.5;
+        double v = stream.Uniform();
+        const double us = 0.5 - std::abs(u);
+        const double k = std::floor((2.0 * a / us + b) * u + c);
+        if (us >= 0.07 && v <= v_r) {
+            return k;
+        }
+        if (k < 0.0 || k > trials) {
+            continue;
+        }
+        v = std::log(v * alpha / (a / (us * us) + b));
+        const double bound =
+            (mode + 0.5) *
+                std::log((mode + 1.0) / (r * (trials - mode + 1.0))) +
+            (trials + 1.0) *
+                std::log((trials - mode + 1.0) / (trials - k + 1.0)) +
+            (k + 0.5) * std::log(r * (trials - k + 1.0) / (k + 1.0)) +
+            StirlingTail(mode) + StirlingTail(trials - mode) -
+            StirlingTail(k) - StirlingTail(trials - k);
+        if (v <= bound) {
+            return k;
+        }
+    }
+}
+
+// Samples with probability <= 0.5, where both methods are efficient.
+double SampleLowerHalf(double trials, double probability,
+                       RandomStream &stream) {
+    if (trials * probability < kInversionMean) {
+        return SampleByInversion(trials, probability, stream);
+    }
+    return SampleByRejection(trials, probability, stream);
+}
+} // namespace
+
+double SampleBinomial(double trials, double probability,
+                      RandomStream &stream) {
+    trials = std::floor(trials);
+    if (!(trials > 0.0) || !(probability > 0.0)) {
+        return 0.0;
+    }
+    if (probability >= 1.0) {
+        return trials;
+    }
+    // successes with probability p are failures with probability 1 - p
+    if (probability > 0.5) {
+        return trials - SampleLowerHalf(trials, 1.0 - probability, stream);
+    }
+    return SampleLowerHalf(trials, probability, stream);
+}
+} // namespace respond
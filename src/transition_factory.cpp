@@ -4,7 +4,7 @@
 // Created Date: 2026-02-05                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-02-05                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -19,8 +19,11 @@
 
 #include <respond/logging.hpp>
 
+#include "internals/aging.hpp"
+#include "internals/axis_transition.hpp"
 #include "internals/background.hpp"
 #include "internals/behavior.hpp"
+#include "internals/entering_cohort.hpp"
 #include "internals/intervention.hpp"
 #include "internals/migration.hpp"
 #include "internals/overdose.hpp"
@@ -43,13 +46,41 @@ TransitionFactory::CreateTransition(const std::string &type,
         return Overdose::Create(type, log_name);
     } else if (type_copy == "background_death") {
         return BackgroundDeath::Create(type, log_name);
+    } else if (type_copy == "entering_cohort") {
+        return EnteringCohort::Create(type, log_name);
     }
 
     // Invalid transition type
     std::string error_msg = "Invalid transition type: '" + type +
                             "'. Supported types: migration, behavior, "
-                            "intervention, overdose, background_death";
+                            "intervention, overdose, background_death, "
+                            "entering_cohort";
     LogError(log_name, error_msg);
     return nullptr;
 }
+
+std::unique_ptr<Transition> TransitionFactory::CreateAxisTransition(
+    const std::string &type, const StateLayout &layout,
+    const std::string &axis, const std::string &log_name) {
+    std::string type_copy = type;
+    std::transform(type_copy.begin(), type_copy.end(), type_copy.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (type_copy == "behavior" || type_copy == "intervention") {
+        return AxisTransition::Create(type, layout, axis,
+                                      type_copy == "intervention", log_name);
+    }
+
+    // Invalid transition type
+    std::string error_msg = "Invalid axis transition type: '" + type +
+                            "'. Supported types: behavior, intervention";
+    LogError(log_name, error_msg);
+    return nullptr;
+}
+
+std::unique_ptr<Transition> TransitionFactory::CreateAgingTransition(
+    const StateLayout &layout, const std::string &axis, int interval,
+    const std::string &log_name) {
+    return Aging::Create("aging", layout, axis, interval, log_name);
+}
 } // namespace respond
\ No newline at end of file
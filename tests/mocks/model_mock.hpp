@@ -4,7 +4,7 @@
 // Created Date: 2025-08-01                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-06-25                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2025-2026 Syndemics Lab at Boston Medical Center             //
@@ -33,9 +33,19 @@ public:
     MOCK_METHOD(void, SetState, (const Eigen::Ref<const Eigen::VectorXd> &),
                 (override));
     MOCK_METHOD(Eigen::VectorXd, GetState, (), (const, override));
+    MOCK_METHOD(void, SetBatchState,
+                (const Eigen::Ref<const Eigen::MatrixXd> &), (override));
+    MOCK_METHOD(Eigen::MatrixXd, GetBatchState, (), (const, override));
+    MOCK_METHOD(bool, IsBatched, (), (const, override));
+    MOCK_METHOD((std::vector<std::map<std::string, History>>),
+                GetBatchHistories, (), (const, override));
     MOCK_METHOD(void, RunTransitions, (), (override));
+    MOCK_METHOD(void, Finalize, (), (override));
+    MOCK_METHOD(bool, IsFinalized, (), (const, override));
     MOCK_METHOD(void, AddTransition, (const std::unique_ptr<Transition> &),
                 (override));
+    MOCK_METHOD(void, AddTransition, (std::unique_ptr<Transition> &&),
+                (override));
     MOCK_METHOD((std::vector<std::string>), GetTransitionNames, (),
                 (const, override));
     MOCK_METHOD(void, ClearTransitions, (), (override));
@@ -44,6 +54,10 @@ public:
     MOCK_METHOD(void, SetHistories, ((const std::map<std::string, History> &)),
                 (override));
     MOCK_METHOD(void, ClearHistories, (), (override));
+    MOCK_METHOD(void, SetSubscribedChannels,
+                (const std::vector<HistoryChannel> &), (override));
+    MOCK_METHOD(std::vector<HistoryChannel>, GetSubscribedChannels, (),
+                (const, override));
     MOCK_METHOD(void, SetHistoryCaptureInterval, (int), (override));
     MOCK_METHOD(int, GetHistoryCaptureInterval, (), (const, override));
     MOCK_METHOD(void, SetFinalTimestep, (int), (override));
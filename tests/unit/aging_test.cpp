@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: aging_test.cpp                                                       //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <respond/transition.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#include <respond/compiled_model.hpp>
+#include <respond/history.hpp>
+#include <respond/model.hpp>
+#include <respond/state_layout.hpp>
+#include <respond/transition_factory.hpp>
+
+namespace respond {
+namespace testing {
+
+class AgingTest : public ::testing::Test {
+public:
+    StateLayout layout;
+    Eigen::VectorXd state;
+    std::map<std::string, History> histories;
+
+protected:
+    void SetUp() override {
+        layout = StateLayout({{"sex", 2}, {"age", 3}, {"behavior", 2}});
+        state = Eigen::VectorXd::LinSpaced(12, 1.0, 12.0);
+    }
+
+    // the permutation-like operator an aging transition stands in for
+    Eigen::MatrixXd AgingMatrix() const {
+        Eigen::MatrixXd ret = Eigen::MatrixXd::Zero(12, 12);
+        for (Eigen::Index sex = 0; sex < 2; ++sex) {
+            for (Eigen::Index age = 0; age < 3; ++age) {
+                for (Eigen::Index b = 0; b < 2; ++b) {
+                    const Eigen::Index from = sex * 6 + age * 2 + b;
+                    ret(from + (age < 2 ? 2 : 0), from) = 1.0;
+                }
+            }
+        }
+        return ret;
+    }
+};
+
+TEST_F(AgingTest, InvalidArguments) {
+    EXPECT_THROW(TransitionFactory::CreateAgingTransition(layout, "race", 2,
+                                                          "test_logger"),
+                 std::runtime_error);
+    EXPECT_THROW(TransitionFactory::CreateAgingTransition(layout, "age", 0,
+                                                          "test_logger"),
+                 std::runtime_error);
+    auto tran = TransitionFactory::CreateAgingTransition(layout, "age", 2,
+                                                         "test_logger");
+    EXPECT_THROW(tran->Validate(11), std::runtime_error);
+    tran->AddTransitionMatrix(Eigen::MatrixXd::Identity(12, 12));
+    EXPECT_THROW(tran->Validate(12), std::runtime_error);
+}
+
+TEST_F(AgingTest, ShiftsStrataOnAgingSteps) {
+    auto tran = TransitionFactory::CreateAgingTransition(layout, "age", 2,
+                                                         "test_logger");
+    EXPECT_FALSE(tran->IsActiveAt(0));
+    EXPECT_FALSE(tran->IsActiveAt(1));
+    EXPECT_TRUE(tran->IsActiveAt(2));
+    EXPECT_TRUE(tran->IsActiveAt(4));
+
+    ExecutionContext ctx(histories);
+    ctx.timestep = 2;
+    Eigen::VectorXd out;
+    tran->ExecuteInto(state, out, ctx);
+    Eigen::VectorXd expected(12);
+    expected << 0, 0, 1, 2, 3 + 5, 4 + 6, 0, 0, 7, 8, 9 + 11, 10 + 12;
+    EXPECT_EQ(out, expected);
+    EXPECT_EQ(out, AgingMatrix() * state);
+
+    ctx.timestep = 3;
+    tran->ExecuteInto(state, out, ctx);
+    EXPECT_EQ(out, state);
+}
+
+TEST_F(AgingTest, BatchShiftsEveryScenario) {
+    auto tran = TransitionFactory::CreateAgingTransition(layout, "age", 1,
+                                                         "test_logger");
+    Eigen::MatrixXd states(12, 2);
+    states << state, state * 2.0;
+    std::vector<std::map<std::string, History>> batch_histories(2);
+    BatchExecutionContext ctx(batch_histories);
+    ctx.timestep = 1;
+    Eigen::MatrixXd out;
+    tran->ExecuteBatch(states, out, ctx);
+    EXPECT_EQ(out, AgingMatrix() * states);
+}
+
+TEST_F(AgingTest, MatchesDenseBehaviorInModel) {
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    Eigen::MatrixXd mixing = Eigen::MatrixXd::Identity(12, 12) * 0.9;
+    for (Eigen::Index i = 0; i < 12; ++i) {
+        mixing((i + 1) % 12, i) += 0.1;
+    }
+    behavior->AddTransitionMatrix(mixing);
+    auto aging = TransitionFactory::CreateAgingTransition(layout, "age", 3,
+                                                          "test_logger");
+
+    auto model = Model::Create("aging", "test_logger");
+    auto compiled =
+        std::make_unique<CompiledModel<double>>("compiled", "test_logger");
+    auto reference = Model::Create("dense", "test_logger");
+    for (auto *m : {model.get(), static_cast<Model *>(compiled.get())}) {
+        m->SetState(state);
+        m->AddTransition(behavior);
+        m->AddTransition(aging);
+    }
+    reference->SetState(state);
+    reference->AddTransition(behavior);
+    model->Finalize();
+    for (int step = 0; step < 10; ++step) {
+        model->RunTransitions();
+        compiled->RunTransitions();
+        reference->RunTransitions();
+        // the dense reference applies the aging matrix by hand
+        if (step > 0 && step % 3 == 0) {
+            reference->SetState(AgingMatrix() * reference->GetState());
+        }
+    }
+    EXPECT_TRUE(model->GetState().isApprox(reference->GetState()));
+    EXPECT_TRUE(compiled->GetState().isApprox(reference->GetState()));
+}
+} // namespace testing
+} // namespace respond
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: axis_transition_test.cpp                                             //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <respond/transition.hpp>
+
+#include <memory>
+
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#include <respond/history.hpp>
+#include <respond/state_layout.hpp>
+#include <respond/transition_factory.hpp>
+
+namespace respond {
+namespace testing {
+
+class AxisTransitionTest : public ::testing::Test {
+public:
+    StateLayout layout;
+    Eigen::VectorXd state;
+    Eigen::MatrixXd behavior_matrix;
+    Eigen::MatrixXd intervention_matrix;
+    std::map<std::string, History> histories;
+
+protected:
+    void SetUp() override {
+        layout = StateLayout({{"intervention", 3}, {"behavior", 2}});
+        state = Eigen::VectorXd::LinSpaced(6, 1.0, 6.0);
+        behavior_matrix = Eigen::MatrixXd(2, 2);
+        behavior_matrix << 0.9, 0.3, 0.1, 0.7;
+        intervention_matrix = Eigen::MatrixXd(3, 3);
+        intervention_matrix << 0.8, 0.1, 0.2, 0.1, 0.8, 0.3, 0.1, 0.1, 0.5;
+    }
+
+    // the full operator an axis transition stands in for
+    static Eigen::MatrixXd Kronecker(const Eigen::MatrixXd &a,
+                                     const Eigen::MatrixXd &b) {
+        Eigen::MatrixXd ret(a.rows() * b.rows(), a.cols() * b.cols());
+        for (Eigen::Index i = 0; i < a.rows(); ++i) {
+            for (Eigen::Index j = 0; j < a.cols(); ++j) {
+                ret.block(i * b.rows(), j * b.cols(), b.rows(), b.cols()) =
+                    a(i, j) * b;
+            }
+        }
+        return ret;
+    }
+};
+
+TEST_F(AxisTransitionTest, UnknownAxis) {
+    EXPECT_THROW(TransitionFactory::CreateAxisTransition("behavior", layout,
+                                                         "age", "test_logger"),
+                 std::runtime_error);
+}
+
+TEST_F(AxisTransitionTest, UnsupportedType) {
+    auto tran = TransitionFactory::CreateAxisTransition(
+        "overdose", layout, "behavior", "test_logger");
+    EXPECT_EQ(tran, nullptr);
+}
+
+TEST_F(AxisTransitionTest, WrongMatrixCount) {
+    auto tran = TransitionFactory::CreateAxisTransition(
+        "behavior", layout, "behavior", "test_logger");
+    tran->AddTransitionMatrix(behavior_matrix);
+    tran->AddTransitionMatrix(behavior_matrix);
+    EXPECT_THROW(tran->Execute(state, histories), std::runtime_error);
+}
+
+TEST_F(AxisTransitionTest, WrongMatrixShape) {
+    auto tran = TransitionFactory::CreateAxisTransition(
+        "behavior", layout, "behavior", "test_logger");
+    tran->AddTransitionMatrix(intervention_matrix);
+    EXPECT_THROW(tran->Execute(state, histories), std::runtime_error);
+}
+
+TEST_F(AxisTransitionTest, SharedMatrixAlongInnerAxis) {
+    auto tran = TransitionFactory::CreateAxisTransition(
+        "behavior", layout, "behavior", "test_logger");
+    tran->AddTransitionMatrix(behavior_matrix);
+    auto result = tran->Execute(state, histories);
+    Eigen::VectorXd expected =
+        Kronecker(Eigen::MatrixXd::Identity(3, 3), behavior_matrix) * state;
+    EXPECT_TRUE(result.isApprox(expected));
+}
+
+TEST_F(AxisTransitionTest, SharedMatrixAlongOuterAxisWritesHistory) {
+    histories["intervention_admission"] =
+        History("intervention_admission", "test_logger");
+    auto tran = TransitionFactory::CreateAxisTransition(
+        "intervention", layout, "intervention", "test_logger");
+    tran->AddTransitionMatrix(intervention_matrix);
+    auto result = tran->Execute(state, histories);
+    Eigen::VectorXd expected =
+        Kronecker(intervention_matrix, Eigen::MatrixXd::Identity(2, 2)) *
+        state;
+    EXPECT_TRUE(result.isApprox(expected));
+    EXPECT_TRUE(histories["intervention_admission"].GetPendingState().isApprox(
+        (expected - state).cwiseMax(0.0)));
+}
+
+TEST_F(AxisTransitionTest, PerSliceMatrices) {
+    // behavior transitions conditional on intervention
+    auto tran = TransitionFactory::CreateAxisTransition(
+        "behavior", layout, "behavior", "test_logger");
+    Eigen::MatrixXd full = Eigen::MatrixXd::Zero(6, 6);
+    for (int i = 0; i < 3; ++i) {
+        Eigen::MatrixXd slice = behavior_matrix * (1.0 - 0.1 * i);
+        tran->AddTransitionMatrix(slice);
+        full.block(i * 2, i * 2, 2, 2) = slice;
+    }
+    auto result = tran->Execute(state, histories);
+    EXPECT_TRUE(result.isApprox(full * state));
+}
+
+TEST_F(AxisTransitionTest, CloneKeepsLayout) {
+    auto tran = TransitionFactory::CreateAxisTransition(
+        "intervention", layout, "intervention", "test_logger");
+    tran->AddTransitionMatrix(intervention_matrix);
+    auto copy = tran->clone();
+    EXPECT_TRUE(copy->Execute(state, histories)
+                    .isApprox(tran->Execute(state, histories)));
+}
+} // namespace testing
+} // namespace respond
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-06                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-02-06                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -73,5 +73,31 @@ TEST_F(BackgroundDeathTest, GoodExecuteWriteHistory) {
     EXPECT_TRUE(histories["background_death"].GetPendingState().isApprox(
         expected_deaths));
 }
+
+TEST_F(BackgroundDeathTest, ValidateRejectsProbabilityAboveOne) {
+    tran->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 1.5));
+    EXPECT_THROW(tran->Validate(state.size()), std::runtime_error);
+}
+
+TEST_F(BackgroundDeathTest, ValidateRejectsWrongSize) {
+    tran->AddTransitionMatrix(tran_matrix);
+    EXPECT_NO_THROW(tran->Validate(state.size()));
+    EXPECT_THROW(tran->Validate(state.size() + 1), std::runtime_error);
+}
+
+TEST_F(BackgroundDeathTest, SelectTimestepSwitchesScheduledMatrices) {
+    tran->AddTransitionMatrix(tran_matrix);
+    tran->AddChangeTime(52);
+    tran->AddTransitionMatrix(Eigen::VectorXd::Zero(3));
+    EXPECT_EQ(tran->GetChangeTimes(), (std::vector<int>{0, 52}));
+    EXPECT_THROW(tran->AddChangeTime(52), std::runtime_error);
+
+    auto copy = tran->clone();
+    copy->SelectTimestep(60);
+    EXPECT_TRUE(copy->Execute(state, histories).isApprox(state));
+    copy->SelectTimestep(51);
+    EXPECT_TRUE(copy->Execute(state, histories)
+                    .isApprox(state - state.cwiseProduct(tran_matrix)));
+}
 } // namespace testing
 } // namespace respond
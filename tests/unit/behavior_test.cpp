@@ -4,7 +4,7 @@
 // Created Date: 2026-02-06                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-02-06                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -12,6 +12,7 @@
 
 #include <respond/transition.hpp>
 
+#include <cmath>
 #include <memory>
 
 #include <Eigen/Dense>
@@ -63,5 +64,81 @@ TEST_F(BehaviorTest, GoodExecuteNoHistory) {
     auto expected = tran_matrix * state;
     EXPECT_TRUE(result.isApprox(expected));
 }
+
+TEST_F(BehaviorTest, ExecuteIntoReusesBuffer) {
+    tran->AddTransitionMatrix(tran_matrix);
+    ExecutionContext ctx(histories);
+    Eigen::VectorXd out(3);
+    const double *buffer = out.data();
+    tran->ExecuteInto(state, out, ctx);
+    EXPECT_EQ(out.data(), buffer);
+    EXPECT_TRUE(out.isApprox(tran_matrix * state));
+}
+
+TEST_F(BehaviorTest, SparseMatrixMatchesDense) {
+    Eigen::SparseMatrix<double> sparse = tran_matrix.sparseView();
+    tran->AddSparseTransitionMatrix(sparse);
+    auto result = tran->Execute(state, histories);
+    EXPECT_TRUE(result.isApprox(tran_matrix * state));
+
+    auto copy = tran->clone();
+    EXPECT_TRUE(copy->Execute(state, histories).isApprox(result));
+}
+
+TEST_F(BehaviorTest, MostlyZeroDenseMatrixMatchesDenseProduct) {
+    // block diagonal, well below the density at which storage turns sparse
+    Eigen::MatrixXd block_matrix = Eigen::MatrixXd::Zero(60, 60);
+    for (int b = 0; b < 12; ++b) {
+        block_matrix.block(b * 5, b * 5, 5, 5).setConstant(0.2);
+    }
+    Eigen::VectorXd large_state = Eigen::VectorXd::LinSpaced(60, 1.0, 60.0);
+    tran->AddTransitionMatrix(block_matrix);
+    auto result = tran->Execute(large_state, histories);
+    EXPECT_TRUE(result.isApprox(block_matrix * large_state));
+}
+TEST_F(BehaviorTest, StochasticDrawsDoNotDependOnStorage) {
+    Eigen::MatrixXd moves(3, 3);
+    moves << 0.7, 0.1, 0.0, 0.3, 0.8, 0.4, 0.0, 0.1, 0.6;
+    Eigen::VectorXd people(3);
+    people << 100.0, 50.5, 20.0;
+    tran->AddTransitionMatrix(moves);
+    auto sparse =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    sparse->AddSparseTransitionMatrix(moves.sparseView());
+
+    const RandomKey key{5, 0};
+    ExecutionContext ctx(histories);
+    ctx.random = &key;
+    ctx.timestep = 3;
+    Eigen::VectorXd dense_out;
+    Eigen::VectorXd sparse_out;
+    tran->ExecuteInto(people, dense_out, ctx);
+    sparse->ExecuteInto(people, sparse_out, ctx);
+    EXPECT_EQ(dense_out, sparse_out);
+    // whole people move, the half stays and the columns conserve everyone
+    EXPECT_DOUBLE_EQ(dense_out.sum(), people.sum());
+    EXPECT_DOUBLE_EQ(dense_out(1) - std::floor(dense_out(1)), 0.5);
+
+    // columns summing to more than 1 would create people
+    auto growing =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    growing->AddTransitionMatrix(tran_matrix);
+    EXPECT_THROW(growing->ExecuteInto(people, dense_out, ctx),
+                 std::runtime_error);
+}
+
+TEST_F(BehaviorTest, ModifyingCloneLeavesOriginalMatrices) {
+    tran->AddTransitionMatrix(tran_matrix);
+    auto copy = tran->clone();
+    copy->ClearTransitionMatrices();
+    copy->AddTransitionMatrix(Eigen::MatrixXd::Identity(3, 3));
+    tran->AddChangeTime(5);
+    tran->AddTransitionMatrix(Eigen::MatrixXd::Zero(3, 3));
+
+    EXPECT_TRUE(copy->Execute(state, histories).isApprox(state));
+    EXPECT_EQ(copy->GetChangeTimes(), std::vector<int>{0});
+    EXPECT_TRUE(tran->Execute(state, histories).isApprox(tran_matrix * state));
+}
+
 } // namespace testing
 } // namespace respond
\ No newline at end of file
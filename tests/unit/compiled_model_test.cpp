@@ -0,0 +1,380 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: compiled_model_test.cpp                                              //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <respond/compiled_model.hpp>
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#include <respond/dual.hpp>
+#include <respond/execution_context.hpp>
+#include <respond/history.hpp>
+#include <respond/model.hpp>
+#include <respond/state_layout.hpp>
+#include <respond/transition_factory.hpp>
+
+namespace respond {
+namespace testing {
+
+// Halves the state, accumulating what it removes through the total overdose
+// slot and snapshotting it into a history looked up by name.
+class RecordingTransition : public Transition {
+public:
+    Eigen::VectorXd Execute(const Eigen::Ref<const Eigen::VectorXd> &s,
+                            std::map<std::string, History> &h) const override {
+        Eigen::VectorXd out;
+        ExecutionContext ctx(h);
+        ExecuteInto(s, out, ctx);
+        return out;
+    }
+    void ExecuteInto(const Eigen::Ref<const Eigen::VectorXd> &s,
+                     Eigen::VectorXd &out,
+                     ExecutionContext &ctx) const override {
+        out = s * 0.5;
+        if (auto *total = ctx.slots[HistoryChannel::kTotalOverdose]) {
+            total->AccumulateState(s * 0.5);
+        }
+        auto removed = ctx.histories.find("removed");
+        if (removed != ctx.histories.end()) {
+            removed->second.AccumulateState(s * 0.5);
+        }
+    }
+    void
+    AddTransitionMatrix(const Eigen::Ref<const Eigen::MatrixXd> &) override {}
+    std::string GetTransitionName() const override { return "recording"; }
+    void ClearTransitionMatrices() override {}
+    std::string GetLogName() const override { return "test_logger"; }
+    std::unique_ptr<Transition> clone() const override {
+        return std::make_unique<RecordingTransition>();
+    }
+};
+
+class CompiledModelTest : public ::testing::Test {
+public:
+    static constexpr int kSize = 65;
+    Eigen::VectorXd state;
+    std::vector<std::unique_ptr<Transition>> chain;
+
+protected:
+    void SetUp() override {
+        state = Eigen::VectorXd::LinSpaced(kSize, 100.0, 5000.0);
+
+        // column-stochastic mixing between neighbouring states
+        Eigen::MatrixXd mixing = Eigen::MatrixXd::Zero(kSize, kSize);
+        for (int i = 0; i < kSize; ++i) {
+            mixing(i, i) = 0.9;
+            mixing((i + 1) % kSize, i) = 0.1;
+        }
+        chain.push_back(
+            TransitionFactory::CreateTransition("behavior", "test_logger"));
+        chain.back()->AddTransitionMatrix(mixing);
+        chain.push_back(
+            TransitionFactory::CreateTransition("intervention", "test_logger"));
+        chain.back()->AddTransitionMatrix(mixing.transpose());
+        chain.push_back(
+            TransitionFactory::CreateTransition("overdose", "test_logger"));
+        chain.back()->AddTransitionMatrix(
+            Eigen::VectorXd::Constant(kSize, 0.004));
+        chain.back()->AddTransitionMatrix(
+            Eigen::VectorXd::Constant(kSize, 0.1));
+        chain.push_back(TransitionFactory::CreateTransition("background_death",
+                                                            "test_logger"));
+        chain.back()->AddTransitionMatrix(
+            Eigen::VectorXd::Constant(kSize, 0.0002));
+        chain.push_back(
+            TransitionFactory::CreateTransition("migration", "test_logger"));
+        chain.back()->AddTransitionMatrix(
+            Eigen::VectorXd::LinSpaced(kSize, -1.0, 3.0));
+    }
+
+    std::unique_ptr<Model> Build(std::unique_ptr<Model> model) const {
+        model->SetState(state);
+        for (const auto &t : chain) {
+            model->AddTransition(t);
+        }
+        return model;
+    }
+
+    // Builds the chain with one matrix entry moved by `delta`.
+    std::unique_ptr<Model> BuildPerturbed(const SensitivityEntry &entry,
+                                          double delta) const {
+        const std::vector<std::string> types = {
+            "behavior", "intervention", "overdose", "background_death",
+            "migration"};
+        auto model =
+            std::make_unique<CompiledModel<double>>("perturbed", "test_logger");
+        model->SetState(state);
+        for (std::size_t i = 0; i < chain.size(); ++i) {
+            auto matrices = chain[i]->CopyTransitionMatrices();
+            if (i == entry.transition) {
+                matrices[entry.matrix](entry.row, entry.col) += delta;
+            }
+            auto t = TransitionFactory::CreateTransition(types[i],
+                                                         "test_logger");
+            for (const auto &m : matrices) {
+                t->AddTransitionMatrix(m);
+            }
+            model->AddTransition(std::move(t));
+        }
+        return model;
+    }
+};
+
+TEST_F(CompiledModelTest, DoublePipelineMatchesMarkov) {
+    auto reference = Build(Model::Create("markov", "test_logger"));
+    auto compiled = Build(
+        std::make_unique<CompiledModel<double>>("compiled", "test_logger"));
+    for (int step = 0; step < 52; ++step) {
+        reference->RunTransitions();
+        compiled->RunTransitions();
+    }
+    EXPECT_TRUE(compiled->IsFinalized());
+    EXPECT_TRUE(compiled->GetState().isApprox(reference->GetState()));
+    EXPECT_EQ(compiled->GetHistories(), reference->GetHistories());
+}
+
+TEST_F(CompiledModelTest, SinglePrecisionTracksDouble) {
+    auto reference = Build(Model::Create("markov", "test_logger"));
+    auto single = Build(
+        Model::Create("single", "test_logger", Precision::kSingle));
+    // ten simulated years of weekly steps
+    for (int step = 0; step < 520; ++step) {
+        reference->RunTransitions();
+        single->RunTransitions();
+    }
+    const Eigen::VectorXd expected = reference->GetState();
+    const double relative_error =
+        ((single->GetState() - expected).cwiseAbs().array() /
+         expected.array())
+            .maxCoeff();
+    EXPECT_LT(relative_error, 1e-4);
+
+    const auto expected_deaths =
+        reference->GetHistories()["fatal_overdose"].GetRecordedStates().back();
+    const auto single_deaths =
+        single->GetHistories()["fatal_overdose"].GetRecordedStates().back();
+    EXPECT_TRUE(single_deaths.isApprox(expected_deaths, 1e-4));
+}
+
+TEST_F(CompiledModelTest, CustomTransitionRunsThroughVirtualPath) {
+    StateLayout layout({{"intervention", 13}, {"behavior", 5}});
+    auto axis = TransitionFactory::CreateAxisTransition(
+        "intervention", layout, "intervention", "test_logger");
+    axis->AddTransitionMatrix(Eigen::MatrixXd::Identity(13, 13) * 0.5 +
+                              Eigen::MatrixXd::Constant(13, 13, 0.5 / 13));
+    chain.push_back(std::move(axis));
+
+    auto reference = Build(Model::Create("markov", "test_logger"));
+    auto single = Build(
+        Model::Create("single", "test_logger", Precision::kSingle));
+    for (int step = 0; step < 10; ++step) {
+        reference->RunTransitions();
+        single->RunTransitions();
+    }
+    EXPECT_TRUE(single->GetState().isApprox(reference->GetState(), 1e-5));
+    const auto expected =
+        reference->GetHistories()["intervention_admission"].GetStateMap();
+    const auto actual =
+        single->GetHistories()["intervention_admission"].GetStateMap();
+    ASSERT_EQ(actual.size(), expected.size());
+    // admissions are differences of states, so they keep fewer digits
+    EXPECT_TRUE(actual.rbegin()->second.isApprox(expected.rbegin()->second,
+                                                 1e-4));
+}
+
+TEST_F(CompiledModelTest, CustomTransitionRecordsCarryOver) {
+    auto reference = Model::Create("markov", "test_logger");
+    auto compiled =
+        std::make_unique<CompiledModel<double>>("compiled", "test_logger");
+    for (Model *model :
+         {reference.get(), static_cast<Model *>(compiled.get())}) {
+        model->SetState(state);
+        model->AddTransition(std::make_unique<RecordingTransition>());
+        model->CreateDefaultHistories();
+        auto histories = model->GetHistories();
+        histories["removed"] =
+            History("removed", "test_logger", HistoryMode::Snapshot);
+        model->SetHistories(histories);
+    }
+    for (int step = 0; step < 5; ++step) {
+        reference->RunTransitions();
+        compiled->RunTransitions();
+    }
+    const auto expected = reference->GetHistories();
+    ASSERT_EQ(expected.at("removed").GetRecordedStates().size(), 5u);
+    EXPECT_EQ(compiled->GetHistories(), expected);
+    EXPECT_TRUE(compiled->GetState().isApprox(reference->GetState()));
+}
+
+TEST_F(CompiledModelTest, InvalidChainThrowsOnFirstRun) {
+    auto model = Build(
+        Model::Create("single", "test_logger", Precision::kSingle));
+    model->SetState(Eigen::VectorXd::Ones(3));
+    EXPECT_THROW(model->RunTransitions(), std::runtime_error);
+    EXPECT_FALSE(model->IsFinalized());
+}
+
+TEST_F(CompiledModelTest, CloneContinuesIndependently) {
+    auto model = Build(
+        Model::Create("single", "test_logger", Precision::kSingle));
+    model->RunTransitions();
+    auto copy = model->clone();
+    model->RunTransitions();
+    copy->RunTransitions();
+    EXPECT_TRUE(copy->GetState().isApprox(model->GetState()));
+    EXPECT_EQ(copy->GetHistories(), model->GetHistories());
+}
+
+TEST_F(CompiledModelTest, FixedSizeMatchesMarkov) {
+    auto reference = Build(Model::Create("markov", "test_logger"));
+    auto fixed = Build(Model::Create<kSize>("fixed", "test_logger"));
+    for (int step = 0; step < 52; ++step) {
+        reference->RunTransitions();
+        fixed->RunTransitions();
+    }
+    EXPECT_TRUE(fixed->GetState().isApprox(reference->GetState()));
+    EXPECT_EQ(fixed->GetHistories(), reference->GetHistories());
+}
+
+TEST_F(CompiledModelTest, FixedSizeRejectsOtherSizes) {
+    auto model = Model::Create<kSize>("fixed", "test_logger",
+                                      Precision::kSingle);
+    EXPECT_TRUE(model->GetState().size() == 0);
+    EXPECT_THROW(model->SetState(Eigen::VectorXd::Ones(kSize + 1)),
+                 std::runtime_error);
+
+    History history("state", "test_logger", HistoryMode::Snapshot);
+    history.RecordSnapshot(Eigen::VectorXd::Ones(3), 0);
+    EXPECT_THROW(model->SetHistories({{"state", history}}),
+                 std::runtime_error);
+}
+
+TEST_F(CompiledModelTest, SubscribedChannelsLimitRecordedHistories) {
+    auto reference = Build(Model::Create("markov", "test_logger"));
+    auto compiled = Build(
+        Model::Create("single", "test_logger", Precision::kSingle));
+    compiled->SetSubscribedChannels({HistoryChannel::kState});
+    for (int step = 0; step < 5; ++step) {
+        reference->RunTransitions();
+        compiled->RunTransitions();
+    }
+    const auto histories = compiled->GetHistories();
+    ASSERT_EQ(histories.size(), 1u);
+    EXPECT_EQ(histories.at("state").GetRecordedTimesteps(),
+              reference->GetHistories().at("state").GetRecordedTimesteps());
+    EXPECT_TRUE(compiled->GetState().isApprox(reference->GetState(), 1e-5));
+}
+
+TEST_F(CompiledModelTest, ScheduledTransitionsMatchMarkov) {
+    chain[3]->AddChangeTime(3);
+    chain[3]->AddTransitionMatrix(Eigen::VectorXd::Constant(kSize, 0.01));
+
+    auto reference = Build(Model::Create("markov", "test_logger"));
+    auto compiled = Build(
+        std::make_unique<CompiledModel<double>>("compiled", "test_logger"));
+    for (int step = 0; step < 6; ++step) {
+        reference->RunTransitions();
+        compiled->RunTransitions();
+    }
+    EXPECT_TRUE(compiled->GetState().isApprox(reference->GetState()));
+    EXPECT_EQ(compiled->GetHistories(), reference->GetHistories());
+}
+
+TEST_F(CompiledModelTest, DualDerivativesMatchFiniteDifferences) {
+    const std::vector<SensitivityEntry> entries = {
+        {0, 0, 1, 0}, {2, 1, 5, 0}, {3, 0, 10, 0}};
+    auto reference = Build(
+        std::make_unique<CompiledModel<double>>("compiled", "test_logger"));
+    auto dual =
+        std::make_unique<CompiledModel<Dual<3>>>("dual", "test_logger");
+    dual->SetSensitivities(entries);
+    dual->SetState(state);
+    for (const auto &t : chain) {
+        dual->AddTransition(t);
+    }
+    for (int step = 0; step < 20; ++step) {
+        reference->RunTransitions();
+        dual->RunTransitions();
+    }
+    // the values are those of the double pipeline
+    EXPECT_TRUE(dual->GetState().isApprox(reference->GetState(), 1e-14));
+
+    const double h = 1e-6;
+    for (int d = 0; d < 3; ++d) {
+        auto up = BuildPerturbed(entries[d], h);
+        auto down = BuildPerturbed(entries[d], -h);
+        for (int step = 0; step < 20; ++step) {
+            up->RunTransitions();
+            down->RunTransitions();
+        }
+        const Eigen::VectorXd expected =
+            (up->GetState() - down->GetState()) / (2.0 * h);
+        const auto expected_deaths =
+            ((up->GetHistories()["fatal_overdose"].GetRecordedStates().back() -
+              down->GetHistories()["fatal_overdose"]
+                  .GetRecordedStates()
+                  .back()) /
+             (2.0 * h))
+                .eval();
+        const auto &deaths = dual->GetTypedHistories()
+                                 .at("fatal_overdose")
+                                 .GetRecordedStates()
+                                 .back();
+        for (int i = 0; i < kSize; ++i) {
+            EXPECT_NEAR(dual->GetTypedState()(i).GetDerivative(d),
+                        expected(i), 1e-4 * (1.0 + std::abs(expected(i))));
+            EXPECT_NEAR(deaths(i).GetDerivative(d), expected_deaths(i),
+                        1e-4 * (1.0 + std::abs(expected_deaths(i))));
+        }
+    }
+}
+
+TEST_F(CompiledModelTest, DualRejectsUndifferentiableChains) {
+    auto dual =
+        std::make_unique<CompiledModel<Dual<1>>>("dual", "test_logger");
+    EXPECT_THROW(dual->SetSensitivities({{0, 0, 0, 0}, {0, 0, 1, 0}}),
+                 std::runtime_error);
+    dual->SetSensitivities({{0, 0, kSize, 0}});
+    dual->SetState(state);
+    for (const auto &t : chain) {
+        dual->AddTransition(t);
+    }
+    EXPECT_THROW(dual->RunTransitions(), std::runtime_error);
+
+    // transitions with change times run in double precision
+    dual->SetSensitivities({{0, 0, 0, 0}});
+    dual->ClearTransitions();
+    chain[3]->AddChangeTime(3);
+    chain[3]->AddTransitionMatrix(Eigen::VectorXd::Constant(kSize, 0.01));
+    for (const auto &t : chain) {
+        dual->AddTransition(t);
+    }
+    EXPECT_THROW(dual->Finalize(), std::runtime_error);
+
+    CompiledModel<double> plain("plain", "test_logger");
+    EXPECT_THROW(plain.SetSensitivities({{0, 0, 0, 0}}), std::runtime_error);
+}
+
+TEST_F(CompiledModelTest, BatchedExecutionIsRejected) {
+    auto model = Model::Create("single", "test_logger", Precision::kSingle);
+    EXPECT_THROW(model->SetBatchState(Eigen::MatrixXd::Ones(3, 2)),
+                 std::runtime_error);
+    EXPECT_FALSE(model->IsBatched());
+}
+} // namespace testing
+} // namespace respond
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: dual_test.cpp                                                        //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <respond/dual.hpp>
+
+#include <algorithm>
+
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+namespace respond {
+namespace testing {
+
+TEST(DualTest, ArithmeticFollowsDerivativeRules) {
+    const auto x = Dual<2>::Variable(3.0, 0);
+    const auto y = Dual<2>::Variable(2.0, 1);
+    const auto f = (x * y + x) / y - 1.0;
+    // f = x + x / y - 1
+    EXPECT_DOUBLE_EQ(f.GetValue(), 3.5);
+    EXPECT_DOUBLE_EQ(f.GetDerivative(0), 1.5);
+    EXPECT_DOUBLE_EQ(f.GetDerivative(1), -0.75);
+    EXPECT_DOUBLE_EQ(sqrt(x * x).GetDerivative(0), 1.0);
+    EXPECT_FALSE(Dual<2>(4.0).HasDerivatives());
+    EXPECT_DOUBLE_EQ(static_cast<double>(f), 3.5);
+}
+
+TEST(DualTest, ComparisonsUseValuesOnly) {
+    const auto x = Dual<1>::Variable(1.0, 0);
+    EXPECT_EQ(x, Dual<1>(1.0));
+    EXPECT_LT(Dual<1>(-1.0), x);
+    EXPECT_DOUBLE_EQ(std::max(Dual<1>(0.0), -x).GetDerivative(0), 0.0);
+    EXPECT_DOUBLE_EQ(abs(-x).GetDerivative(0), 1.0);
+}
+
+TEST(DualTest, EigenProductsPropagateDerivatives) {
+    Eigen::Matrix<Dual<1>, 2, 2> m;
+    m << 0.9, 0.2, 0.1, 0.8;
+    m(1, 0).SetDerivative(0, 1.0);
+    Eigen::Matrix<Dual<1>, 2, 1> v;
+    v << 10.0, 20.0;
+    const Eigen::Matrix<Dual<1>, 2, 1> out = m * v;
+    EXPECT_DOUBLE_EQ(out(1).GetValue(), 17.0);
+    EXPECT_DOUBLE_EQ(out(1).GetDerivative(0), 10.0);
+    EXPECT_DOUBLE_EQ(out(0).GetDerivative(0), 0.0);
+    EXPECT_DOUBLE_EQ(out.sum().GetDerivative(0), 10.0);
+}
+} // namespace testing
+} // namespace respond
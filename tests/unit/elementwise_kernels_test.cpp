@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: elementwise_kernels_test.cpp                                         //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <respond/elementwise_kernels.hpp>
+
+#include <map>
+#include <string>
+
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#include <respond/execution_context.hpp>
+#include <respond/history.hpp>
+#include <respond/transition_factory.hpp>
+
+namespace respond {
+namespace testing {
+
+class ElementwiseKernelsTest : public ::testing::Test {
+public:
+    Eigen::VectorXd state;
+    Eigen::VectorXd overdose;
+    Eigen::VectorXd fatality;
+
+protected:
+    void SetUp() override {
+        state = Eigen::VectorXd::LinSpaced(7, 1.0, 7.0);
+        overdose = Eigen::VectorXd::LinSpaced(7, 0.1, 0.4);
+        fatality = Eigen::VectorXd::Constant(7, 0.5);
+    }
+};
+
+TEST_F(ElementwiseKernelsTest, BlocksMatchWholeVector) {
+    Eigen::VectorXd whole = state;
+    History total("total_overdose", "test_logger", HistoryMode::Accumulated);
+    History fatal("fatal_overdose", "test_logger", HistoryMode::Accumulated);
+    OverdoseKernel(whole.array(), overdose.array(), fatality.array(),
+                   HistorySink(&total), HistorySink(&fatal));
+
+    Eigen::ArrayXd blocked = state.array();
+    Eigen::VectorXd total_blocks = Eigen::VectorXd::Zero(7);
+    for (Eigen::Index start : {0, 4}) {
+        const Eigen::Index length = start == 0 ? 4 : 3;
+        OverdoseKernel(blocked.segment(start, length),
+                       overdose.segment(start, length).array(),
+                       fatality.segment(start, length).array(),
+                       AccumulatorSink(total_blocks.data(), start),
+                       AccumulatorSink<double>(nullptr, start));
+    }
+    EXPECT_EQ(whole, blocked.matrix());
+    EXPECT_EQ(total.GetPendingAccumulator(7), total_blocks);
+    EXPECT_EQ(whole, state - fatal.GetPendingAccumulator(7));
+}
+
+TEST_F(ElementwiseKernelsTest, MigrationClampsAtZero) {
+    Eigen::VectorXd migrants = Eigen::VectorXd::Constant(7, -3.0);
+    Eigen::VectorXd result = state;
+    MigrationKernel(result.array(), migrants.array());
+    EXPECT_EQ(result, (state + migrants).cwiseMax(0.0));
+}
+
+TEST_F(ElementwiseKernelsTest, TransitionsRunTheKernels) {
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(overdose);
+    std::map<std::string, History> histories = {
+        {"background_death", History("background_death", "test_logger",
+                                     HistoryMode::Accumulated)}};
+    Eigen::VectorXd out;
+    ExecutionContext ctx(histories);
+    death->ExecuteInto(state, out, ctx);
+
+    Eigen::VectorXd expected = state;
+    Eigen::VectorXd deaths = Eigen::VectorXd::Zero(7);
+    BackgroundDeathKernel(expected.array(), overdose.array(),
+                          AccumulatorSink(deaths.data(), 0));
+    EXPECT_EQ(out, expected);
+    EXPECT_EQ(histories.at("background_death").GetPendingAccumulator(7),
+              deaths);
+}
+} // namespace testing
+} // namespace respond
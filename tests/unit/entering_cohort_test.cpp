@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: entering_cohort_test.cpp                                             //
+// Project: respond                                                           //
+// Created Date: 2026-02-06                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <respond/transition.hpp>
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <gtest/gtest.h>
+
+#include <respond/history.hpp>
+#include <respond/model.hpp>
+#include <respond/transition_factory.hpp>
+
+namespace respond {
+namespace testing {
+
+class EnteringCohortTest : public ::testing::Test {
+public:
+    static constexpr int kSize = 600;
+    std::unique_ptr<Transition> tran;
+    Eigen::VectorXd state;
+    std::map<std::string, History> histories;
+
+protected:
+    void SetUp() override {
+        tran = TransitionFactory::CreateTransition("entering_cohort",
+                                                   "test_logger");
+        state = Eigen::VectorXd::LinSpaced(kSize, 1.0, 600.0);
+    }
+
+    // an injection with a few arrivals spread over the state
+    static Eigen::SparseMatrix<double> Injection(double count) {
+        Eigen::SparseMatrix<double> ret(kSize, 1);
+        ret.insert(3, 0) = count;
+        ret.insert(257, 0) = 2.0 * count;
+        ret.insert(599, 0) = -1000.0;
+        return ret;
+    }
+
+    // the same time series as dense migration vectors
+    static std::unique_ptr<Transition> DenseMigration() {
+        auto ret =
+            TransitionFactory::CreateTransition("migration", "test_logger");
+        ret->AddTransitionMatrix(Eigen::VectorXd::Zero(kSize));
+        ret->AddChangeTime(3);
+        ret->AddTransitionMatrix(Eigen::MatrixXd(Injection(5.0)));
+        ret->AddChangeTime(7);
+        ret->AddTransitionMatrix(Eigen::MatrixXd(Injection(1.0)));
+        return ret;
+    }
+
+    void AddSeries(Transition &t) const {
+        t.AddSparseTransitionMatrix(Eigen::SparseMatrix<double>(kSize, 1));
+        t.AddChangeTime(3);
+        t.AddSparseTransitionMatrix(Injection(5.0));
+        t.AddChangeTime(7);
+        t.AddSparseTransitionMatrix(Injection(1.0));
+    }
+};
+
+TEST_F(EnteringCohortTest, InjectsOnlyListedEntries) {
+    tran->AddSparseTransitionMatrix(Injection(5.0));
+    EXPECT_EQ(tran->GetKind(), TransitionKind::kMigration);
+    Eigen::VectorXd out;
+    ExecutionContext ctx(histories);
+    tran->ExecuteInto(state, out, ctx);
+    Eigen::VectorXd expected = state;
+    expected(3) += 5.0;
+    expected(257) += 10.0;
+    // emigration is clamped at zero like Migration's
+    expected(599) = 0.0;
+    EXPECT_EQ(out, expected);
+}
+
+TEST_F(EnteringCohortTest, InvalidInjections) {
+    Eigen::VectorXd out;
+    ExecutionContext ctx(histories);
+    EXPECT_THROW(tran->ExecuteInto(state, out, ctx), std::runtime_error);
+    tran->AddTransitionMatrix(Eigen::VectorXd::Ones(kSize - 1));
+    EXPECT_THROW(tran->ExecuteInto(state, out, ctx), std::runtime_error);
+    tran->ClearTransitionMatrices();
+    tran->AddTransitionMatrix(Eigen::MatrixXd::Ones(kSize, 2));
+    EXPECT_THROW(tran->ExecuteInto(state, out, ctx), std::runtime_error);
+    EXPECT_THROW(tran->AddChangeTime(0), std::runtime_error);
+}
+
+TEST_F(EnteringCohortTest, FollowsSeriesAsTimeAdvances) {
+    AddSeries(*tran);
+    EXPECT_EQ(tran->GetChangeTimes(), (std::vector<int>{0, 3, 7}));
+    auto dense = DenseMigration();
+    Eigen::VectorXd out;
+    Eigen::VectorXd expected;
+    for (int timestep : {0, 1, 2, 3, 6, 7, 20, 4, 0}) {
+        tran->SelectTimestep(timestep);
+        dense->SelectTimestep(timestep);
+        ExecutionContext ctx(histories);
+        tran->ExecuteInto(state, out, ctx);
+        dense->ExecuteInto(state, expected, ctx);
+        EXPECT_EQ(out, expected) << "timestep " << timestep;
+    }
+    // clones share the series but keep their own position in it
+    auto copy = tran->clone();
+    copy->SelectTimestep(3);
+    ExecutionContext ctx(histories);
+    copy->ExecuteInto(state, out, ctx);
+    EXPECT_EQ(out(3), state(3) + 5.0);
+    tran->ExecuteInto(state, out, ctx);
+    EXPECT_EQ(out, state);
+}
+
+TEST_F(EnteringCohortTest, MatchesDenseMigrationInModels) {
+    auto overdose =
+        TransitionFactory::CreateTransition("overdose", "test_logger");
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(kSize, 0.01));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(kSize, 0.1));
+    AddSeries(*tran);
+    auto dense = DenseMigration();
+
+    auto model = Model::Create("sparse", "test_logger");
+    auto fast = Model::Create("fast", "test_logger");
+    auto reference = Model::Create("dense", "test_logger");
+    for (auto *m : {model.get(), fast.get()}) {
+        m->SetState(state);
+        m->AddTransition(overdose);
+        m->AddTransition(tran);
+    }
+    reference->SetState(state);
+    reference->AddTransition(overdose);
+    reference->AddTransition(dense);
+    // the finalized model fuses the entering cohort with the overdoses
+    model->Finalize();
+    fast->Finalize();
+    fast->RunFor(12);
+    for (int step = 0; step < 12; ++step) {
+        model->RunTransitions();
+        reference->RunTransitions();
+    }
+    EXPECT_EQ(model->GetState(), reference->GetState());
+    EXPECT_EQ(model->GetHistories(), reference->GetHistories());
+    EXPECT_TRUE(fast->GetState().isApprox(reference->GetState(), 1e-12));
+}
+
+TEST_F(EnteringCohortTest, ArrivalsFastForwardLikeMigration) {
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Constant(kSize, 0.001));
+    Eigen::SparseMatrix<double> arrivals(kSize, 1);
+    arrivals.insert(0, 0) = 25.0;
+    tran->AddSparseTransitionMatrix(arrivals);
+
+    auto model = Model::Create("arrivals", "test_logger");
+    model->SetState(state);
+    model->AddTransition(death);
+    model->AddTransition(tran);
+    model->SetHistoryCaptureInterval(52);
+    model->Finalize();
+    auto stepwise = model->clone();
+    model->RunFor(520);
+    for (int step = 0; step < 520; ++step) {
+        stepwise->RunTransitions();
+    }
+    EXPECT_TRUE(model->GetState().isApprox(stepwise->GetState(), 1e-10));
+    // x' = 0.999x + 25 for the element people arrive in
+    const double survival = std::pow(0.999, 520);
+    const double expected =
+        survival * state(0) + 25.0 * (1.0 - survival) / 0.001;
+    EXPECT_NEAR(model->GetState()(0), expected, 1e-9 * expected);
+}
+} // namespace testing
+} // namespace respond
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: history_recorder_test.cpp                                            //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <respond/history_recorder.hpp>
+
+#include <map>
+#include <string>
+
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#include <respond/history.hpp>
+
+namespace respond {
+namespace testing {
+
+class HistoryRecorderTest : public ::testing::Test {
+public:
+    HistoryRecorder recorder;
+};
+
+TEST_F(HistoryRecorderTest, RecordsAtIntervalAndFinalTimestep) {
+    recorder.SetCaptureInterval(4);
+    recorder.SetFinalTimestep(10);
+    EXPECT_TRUE(recorder.ShouldRecord(0));
+    EXPECT_FALSE(recorder.ShouldRecord(3));
+    EXPECT_TRUE(recorder.ShouldRecord(8));
+    EXPECT_TRUE(recorder.ShouldRecord(10));
+    EXPECT_EQ(recorder.NextRecordTimestep(5), 8);
+    EXPECT_EQ(recorder.NextRecordTimestep(8), 10);
+    EXPECT_EQ(recorder.RecordsFrom(0), 3u);
+}
+
+TEST_F(HistoryRecorderTest, CaptureIntervalIsAtLeastOne) {
+    recorder.SetCaptureInterval(0);
+    EXPECT_EQ(recorder.GetCaptureInterval(), 1);
+}
+
+TEST_F(HistoryRecorderTest, RecordCreatesSubscribedHistories) {
+    recorder.SetSubscribedChannels(
+        {HistoryChannel::kState, HistoryChannel::kBackgroundDeath});
+    auto histories = HistoryRecorder::DefaultHistories("test_logger");
+    recorder.DropUnsubscribed(histories);
+    EXPECT_EQ(histories.size(), 2u);
+    histories.erase("background_death");
+
+    HistorySlots slots(histories, recorder.GetSubscribed());
+    Eigen::VectorXd state = Eigen::VectorXd::Constant(3, 2.0);
+    EXPECT_TRUE(recorder.Record(histories, slots, state, 0));
+    EXPECT_FALSE(recorder.Record(histories, slots, state, 1));
+    EXPECT_EQ(histories.size(), 2u);
+    EXPECT_EQ(HistoryRecorder::LatestRecordedTimestep(histories), 1);
+}
+} // namespace testing
+} // namespace respond
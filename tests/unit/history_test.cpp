@@ -4,13 +4,16 @@
 // Created Date: 2026-05-05                                                   //
 // Author: GitHub Copilot                                                     //
 // -----                                                                      //
-// Last Modified: 2026-05-05                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: GitHub Copilot                                                //
 // -----                                                                      //
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <respond/history.hpp>
 
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -116,5 +119,108 @@ TEST(HistoryTest, AccumulatedHistoryFlushesZeroWhenNoPendingStateExists) {
     EXPECT_TRUE(history.GetRecordedStates()[0].isZero());
 }
 
+TEST(HistoryTest, FlushKeepsPendingBuffer) {
+    History history("total_overdose", "test_logger", HistoryMode::Accumulated);
+    history.Reserve(3, 2);
+    const double *buffer = history.GetPendingAccumulator(2).data();
+
+    history.GetPendingAccumulator(2).setOnes();
+    history.FlushPendingState(1, 2);
+    EXPECT_FALSE(history.HasPendingState());
+    EXPECT_EQ(history.GetPendingState().size(), 0);
+
+    history.AccumulateState(Eigen::VectorXd::Constant(2, 2.0));
+    EXPECT_EQ(history.GetPendingAccumulator(2).data(), buffer);
+    history.FlushPendingState(2, 2);
+    history.FlushPendingState(3, 2);
+
+    const std::vector<int> expected_timesteps = {1, 2, 3};
+    ASSERT_EQ(history.GetRecordedTimesteps(), expected_timesteps);
+    EXPECT_TRUE(history.GetRecordedStates()[0].isOnes());
+    EXPECT_TRUE(history.GetRecordedStates()[1].isConstant(2.0));
+    EXPECT_TRUE(history.GetRecordedStates()[2].isZero());
+}
+
+TEST(HistoryTest, AssignmentKeepsPendingState) {
+    History history("total_overdose", "test_logger", HistoryMode::Accumulated);
+    history.RecordSnapshot(Eigen::VectorXd::Ones(2), 1);
+    history.AccumulateState(Eigen::VectorXd::Constant(2, 3.0));
+
+    History copied;
+    copied = history;
+    EXPECT_TRUE(copied.HasPendingState());
+    EXPECT_TRUE(copied.GetPendingState().isConstant(3.0));
+
+    History moved;
+    moved = std::move(history);
+    EXPECT_TRUE(moved.HasPendingState());
+    EXPECT_TRUE(moved.GetPendingState().isConstant(3.0));
+    EXPECT_EQ(moved.GetRecordedTimesteps(), std::vector<int>{1});
+    EXPECT_FALSE(history.HasPendingState());
+
+    // swap goes through move assignment
+    History other("total_overdose", "test_logger", HistoryMode::Accumulated);
+    std::swap(moved, other);
+    EXPECT_FALSE(moved.HasPendingState());
+    EXPECT_TRUE(other.HasPendingState());
+    EXPECT_TRUE(other.GetPendingState().isConstant(3.0));
+}
+
+TEST(HistoryTest, AppendRecordsContinuesSplitHistory) {
+    History history("total_overdose", "test_logger", HistoryMode::Accumulated);
+    history.AccumulateState(Eigen::VectorXd::Ones(2));
+    history.FlushPendingState(1, 2);
+    history.AccumulateState(Eigen::VectorXd::Constant(2, 2.0));
+
+    History later = history.WithoutRecords();
+    EXPECT_EQ(later.GetLatestRecordedTimestep(), -1);
+    ASSERT_TRUE(later.HasPendingState());
+    later.AccumulateState(Eigen::VectorXd::Ones(2));
+    later.FlushPendingState(2, 2);
+
+    history.AppendRecords(later);
+    const std::vector<int> expected_timesteps = {1, 2};
+    ASSERT_EQ(history.GetRecordedTimesteps(), expected_timesteps);
+    EXPECT_TRUE(history.GetRecordedStates()[0].isOnes());
+    EXPECT_TRUE(history.GetRecordedStates()[1].isConstant(3.0));
+    EXPECT_FALSE(history.HasPendingState());
+}
+
+TEST(HistoryTest, ConvertsBetweenPrecisions) {
+    History history("total_overdose", "test_logger");
+    Eigen::VectorXd state(2);
+    state << 0.25, 1.5;
+    history.AddState(state, 0);
+    history.AccumulateState(state);
+
+    BasicHistory<float> single(history);
+    EXPECT_EQ(single.GetHistoryName(), "total_overdose");
+    EXPECT_EQ(single.GetHistoryMode(), HistoryMode::Accumulated);
+    EXPECT_EQ(single.GetRecordedTimesteps(), history.GetRecordedTimesteps());
+    EXPECT_TRUE(single.GetPendingState().isApprox(state.cast<float>()));
+
+    History round_trip(single);
+    EXPECT_EQ(round_trip, history);
+}
+
+TEST(HistoryTest, SlotsResolveChannelsByName) {
+    std::map<std::string, History> histories;
+    histories["state"] = History("state", "test_logger");
+    histories["fatal_overdose"] = History("fatal_overdose", "test_logger");
+
+    HistorySlots slots(histories);
+    EXPECT_EQ(slots[HistoryChannel::kState], &histories["state"]);
+    EXPECT_EQ(slots[HistoryChannel::kFatalOverdose],
+              &histories["fatal_overdose"]);
+    EXPECT_EQ(slots[HistoryChannel::kTotalOverdose], nullptr);
+    EXPECT_FALSE(slots.IsComplete());
+
+    slots.ResolveOrCreate(histories);
+    EXPECT_TRUE(slots.IsComplete());
+    EXPECT_EQ(histories.size(), 5u);
+    EXPECT_EQ(slots[HistoryChannel::kBackgroundDeath],
+              &histories["background_death"]);
+}
+
 } // namespace testing
 } // namespace respond
\ No newline at end of file
@@ -79,5 +79,20 @@ TEST_F(InterventionTest, GoodExecuteWriteHistory) {
     EXPECT_TRUE(histories["intervention_admission"].GetPendingState().isApprox(
         expected_admissions));
 }
+
+TEST_F(InterventionTest, SparseMatrixWritesHistory) {
+    History h("intervention_admission", "test_logger");
+    histories["intervention_admission"] = h;
+    Eigen::SparseMatrix<double> sparse = tran_matrix.sparseView();
+    tran->AddSparseTransitionMatrix(sparse);
+    auto result = tran->Execute(state, histories);
+    auto expected_return = tran_matrix * state;
+    auto expected_admissions =
+        (expected_return - state).cwiseMax(Eigen::VectorXd::Zero(3));
+
+    EXPECT_TRUE(result.isApprox(expected_return));
+    EXPECT_TRUE(histories["intervention_admission"].GetPendingState().isApprox(
+        expected_admissions));
+}
 } // namespace testing
 } // namespace respond
\ No newline at end of file
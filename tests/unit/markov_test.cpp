@@ -4,7 +4,7 @@
 // Created Date: 2025-06-06                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-02-06                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2025-2026 Syndemics Lab at Boston Medical Center             //
@@ -12,11 +12,17 @@
 
 #include <respond/model.hpp>
 
+#include <map>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <Eigen/Dense>
 #include <gtest/gtest.h>
 
+#include <respond/history.hpp>
+#include <respond/state_layout.hpp>
 #include <respond/transition_factory.hpp>
 
 #include "../mocks/transition_mock.hpp"
@@ -69,7 +75,23 @@ TEST_F(MarkovTest, TransitionNames) {
     EXPECT_CALL(*upmt, clone())
         .WillOnce(::testing::Return(::testing::ByMove(std::move(clone))));
 
+    std::unique_ptr<Transition> original = std::move(upmt);
+    markov->AddTransition(original);
+    auto names = markov->GetTransitionNames();
+    ASSERT_EQ(names.size(), 1u);
+    EXPECT_EQ(names[0], "test_transition");
+}
+
+TEST_F(MarkovTest, AddTransitionTakesOwnershipOfTemporaries) {
+    // Handing over the pointer must not copy the transition.
+    auto mock = std::make_unique<NiceMock<MockTransition>>();
+    EXPECT_CALL(*mock, clone()).Times(0);
+    EXPECT_CALL(*mock, GetTransitionName())
+        .WillOnce(Return(std::string("test_transition")));
+
+    std::unique_ptr<Transition> upmt = std::move(mock);
     markov->AddTransition(std::move(upmt));
+    EXPECT_EQ(upmt, nullptr);
     auto names = markov->GetTransitionNames();
     ASSERT_EQ(names.size(), 1u);
     EXPECT_EQ(names[0], "test_transition");
@@ -85,7 +107,8 @@ TEST_F(MarkovTest, RunTransitions) {
     EXPECT_CALL(*upmt, clone())
         .WillOnce(::testing::Return(::testing::ByMove(std::move(clone))));
 
-    markov->AddTransition(std::move(upmt));
+    std::unique_ptr<Transition> original = std::move(upmt);
+    markov->AddTransition(original);
     markov->RunTransitions();
 }
 
@@ -163,7 +186,8 @@ TEST_F(MarkovTest, ClearTransitions) {
     EXPECT_CALL(*upmt, clone())
         .WillOnce(::testing::Return(::testing::ByMove(std::move(clone))));
 
-    markov->AddTransition(std::move(upmt));
+    std::unique_ptr<Transition> original = std::move(upmt);
+    markov->AddTransition(original);
     markov->ClearTransitions();
     auto names = markov->GetTransitionNames();
     ASSERT_EQ(names.size(), 0);
@@ -184,6 +208,778 @@ TEST_F(MarkovTest, Histories) {
     EXPECT_EQ(result["temp"], h);
 }
 
+TEST_F(MarkovTest, FinalizeWithoutStateThrows) {
+    EXPECT_THROW(markov->Finalize(), std::runtime_error);
+    EXPECT_FALSE(markov->IsFinalized());
+}
+
+TEST_F(MarkovTest, FinalizeRejectsMismatchedTransition) {
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(Eigen::MatrixXd::Identity(2, 2));
+    markov->SetState(state);
+    markov->AddTransition(behavior);
+    EXPECT_THROW(markov->Finalize(), std::runtime_error);
+    EXPECT_FALSE(markov->IsFinalized());
+}
+
+TEST_F(MarkovTest, FinalizeRejectsRectangularOperator) {
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(Eigen::MatrixXd::Ones(4, 3));
+    auto intervention =
+        TransitionFactory::CreateTransition("intervention", "test_logger");
+    intervention->AddTransitionMatrix(Eigen::MatrixXd::Identity(3, 3));
+    markov->SetState(state);
+    markov->AddTransition(behavior);
+    markov->AddTransition(intervention);
+    EXPECT_THROW(markov->Finalize(), std::runtime_error);
+    EXPECT_FALSE(markov->IsFinalized());
+
+    auto rectangular =
+        TransitionFactory::CreateTransition("intervention", "test_logger");
+    rectangular->AddTransitionMatrix(Eigen::MatrixXd::Ones(4, 3));
+    EXPECT_THROW(rectangular->Validate(3), std::runtime_error);
+}
+
+TEST_F(MarkovTest, FinalizedRunMatchesCheckedRun) {
+    Eigen::MatrixXd behavior_matrix(3, 3);
+    behavior_matrix << 0.8, 0.1, 0.0, 0.2, 0.8, 0.1, 0.0, 0.1, 0.9;
+    Eigen::VectorXd death_rate = Eigen::VectorXd::Constant(3, 0.01);
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(behavior_matrix);
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(death_rate);
+
+    markov->SetState(state);
+    markov->AddTransition(behavior);
+    markov->AddTransition(death);
+    auto checked = markov->clone();
+
+    markov->Finalize();
+    ASSERT_TRUE(markov->IsFinalized());
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+        checked->RunTransitions();
+    }
+    EXPECT_TRUE(markov->GetState().isApprox(checked->GetState()));
+    EXPECT_EQ(markov->GetHistories(), checked->GetHistories());
+}
+
+TEST_F(MarkovTest, FusedElementwiseRunMatchesCheckedRun) {
+    // spans several fused blocks with a partial block at the end
+    const Eigen::Index size = 600;
+    Eigen::VectorXd large_state = Eigen::VectorXd::LinSpaced(size, 1.0, 60.0);
+    auto overdose =
+        TransitionFactory::CreateTransition("overdose", "test_logger");
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(size, 0.05));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::LinSpaced(size, 0.0, 0.5));
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Constant(size, 0.01));
+    auto migration =
+        TransitionFactory::CreateTransition("migration", "test_logger");
+    migration->AddTransitionMatrix(Eigen::VectorXd::LinSpaced(size, -2.0, 2.0));
+
+    markov->SetState(large_state);
+    markov->AddTransition(overdose);
+    markov->AddTransition(death);
+    markov->AddTransition(migration);
+    auto checked = markov->clone();
+
+    markov->Finalize();
+    ASSERT_TRUE(markov->IsFinalized());
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+        checked->RunTransitions();
+    }
+    EXPECT_TRUE(markov->GetState().isApprox(checked->GetState()));
+    EXPECT_EQ(markov->GetHistories(), checked->GetHistories());
+}
+
+TEST_F(MarkovTest, FusedRunFallsBackForSnapshotOutcomes) {
+    auto overdose =
+        TransitionFactory::CreateTransition("overdose", "test_logger");
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.1));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.2));
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.01));
+
+    markov->SetState(state);
+    markov->SetHistories(
+        {{"total_overdose",
+          History("total_overdose", "test_logger", HistoryMode::Snapshot)},
+         {"background_death", History("background_death", "test_logger",
+                                      HistoryMode::Accumulated)}});
+    markov->AddTransition(overdose);
+    markov->AddTransition(death);
+    auto checked = markov->clone();
+
+    markov->Finalize();
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+        checked->RunTransitions();
+    }
+    EXPECT_TRUE(markov->GetState().isApprox(checked->GetState()));
+    EXPECT_EQ(markov->GetHistories(), checked->GetHistories());
+}
+
+TEST_F(MarkovTest, FinalizedChainWithCustomTransitionMatchesCheckedRun) {
+    StateLayout layout({{"intervention", 2}, {"behavior", 3}});
+    auto axis = TransitionFactory::CreateAxisTransition(
+        "behavior", layout, "behavior", "test_logger");
+    Eigen::MatrixXd mixing(3, 3);
+    mixing << 0.8, 0.1, 0.0, 0.2, 0.8, 0.1, 0.0, 0.1, 0.9;
+    axis->AddTransitionMatrix(mixing);
+    auto overdose =
+        TransitionFactory::CreateTransition("overdose", "test_logger");
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(6, 0.1));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(6, 0.2));
+
+    markov->SetState(Eigen::VectorXd::LinSpaced(6, 10.0, 60.0));
+    markov->AddTransition(axis);
+    markov->AddTransition(overdose);
+    auto checked = markov->clone();
+
+    markov->Finalize();
+    ASSERT_TRUE(markov->IsFinalized());
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+        checked->RunTransitions();
+    }
+    EXPECT_TRUE(markov->GetState().isApprox(checked->GetState()));
+    EXPECT_EQ(markov->GetHistories(), checked->GetHistories());
+}
+
+TEST_F(MarkovTest, SubscribedChannelsLimitRecordedHistories) {
+    auto intervention =
+        TransitionFactory::CreateTransition("intervention", "test_logger");
+    Eigen::MatrixXd intervention_matrix(3, 3);
+    intervention_matrix << 0.8, 0.1, 0.0, 0.2, 0.8, 0.1, 0.0, 0.1, 0.9;
+    intervention->AddTransitionMatrix(intervention_matrix);
+    auto overdose =
+        TransitionFactory::CreateTransition("overdose", "test_logger");
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.1));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.2));
+
+    markov->SetState(state);
+    markov->AddTransition(intervention);
+    markov->AddTransition(overdose);
+    auto reference = markov->clone();
+    markov->SetSubscribedChannels({HistoryChannel::kFatalOverdose});
+
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+        reference->RunTransitions();
+    }
+    const auto histories = markov->GetHistories();
+    ASSERT_EQ(histories.size(), 1u);
+    EXPECT_EQ(histories.at("fatal_overdose"),
+              reference->GetHistories().at("fatal_overdose"));
+    EXPECT_TRUE(markov->GetState().isApprox(reference->GetState()));
+}
+
+TEST_F(MarkovTest, NoSubscribedChannelsRunsStateUpdateOnly) {
+    auto overdose =
+        TransitionFactory::CreateTransition("overdose", "test_logger");
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.1));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.2));
+
+    markov->SetState(state);
+    markov->AddTransition(overdose);
+    auto reference = markov->clone();
+    markov->SetSubscribedChannels({});
+    EXPECT_TRUE(markov->GetSubscribedChannels().empty());
+
+    markov->Finalize();
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+        reference->RunTransitions();
+    }
+    EXPECT_TRUE(markov->GetHistories().empty());
+    EXPECT_TRUE(markov->GetState().isApprox(reference->GetState()));
+}
+
+TEST_F(MarkovTest, ScheduledTransitionsSwitchAtChangeTimes) {
+    Eigen::MatrixXd swap_first(3, 3);
+    swap_first << 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0;
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(Eigen::MatrixXd::Identity(3, 3));
+    behavior->AddChangeTime(1);
+    behavior->AddTransitionMatrix(swap_first);
+    behavior->AddChangeTime(2);
+    behavior->AddTransitionMatrix(Eigen::MatrixXd::Identity(3, 3));
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Zero(3));
+    death->AddChangeTime(2);
+    death->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.5));
+
+    markov->SetState(state);
+    markov->AddTransition(behavior);
+    markov->AddTransition(death);
+    auto checked = markov->clone();
+    markov->Finalize();
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+        checked->RunTransitions();
+    }
+    Eigen::VectorXd expected(3);
+    expected << 1.0, 0.5, 1.5;
+    EXPECT_TRUE(markov->GetState().isApprox(expected));
+    EXPECT_TRUE(checked->GetState().isApprox(expected));
+    EXPECT_EQ(markov->GetHistories(), checked->GetHistories());
+}
+
+TEST_F(MarkovTest, FinalizeValidatesEveryScheduleSegment) {
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Zero(3));
+    death->AddChangeTime(10);
+    death->AddTransitionMatrix(Eigen::VectorXd::Zero(4));
+    markov->SetState(state);
+    markov->AddTransition(death);
+    EXPECT_THROW(markov->Finalize(), std::runtime_error);
+}
+
+// Adds a behavior, overdose, background death and migration chain whose
+// migrants are the given constant.
+void AddAffineChain(Model &model, double migrants) {
+    Eigen::MatrixXd behavior_matrix(3, 3);
+    behavior_matrix << 0.8, 0.1, 0.0, 0.2, 0.8, 0.1, 0.0, 0.1, 0.9;
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(behavior_matrix);
+    auto overdose =
+        TransitionFactory::CreateTransition("overdose", "test_logger");
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.01));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.2));
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.001));
+    auto migration =
+        TransitionFactory::CreateTransition("migration", "test_logger");
+    migration->AddTransitionMatrix(Eigen::VectorXd::Constant(3, migrants));
+    model.AddTransition(behavior);
+    model.AddTransition(overdose);
+    model.AddTransition(death);
+    model.AddTransition(migration);
+}
+
+void ExpectHistoriesNear(const std::map<std::string, History> &actual,
+                         const std::map<std::string, History> &expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (const auto &kv : expected) {
+        const auto &history = actual.at(kv.first);
+        ASSERT_EQ(history.GetRecordedTimesteps(),
+                  kv.second.GetRecordedTimesteps());
+        for (std::size_t i = 0; i < history.GetRecordedStates().size(); ++i) {
+            EXPECT_TRUE(history.GetRecordedStates()[i].isApprox(
+                kv.second.GetRecordedStates()[i], 1e-9))
+                << kv.first << " at record " << i;
+        }
+    }
+}
+
+TEST_F(MarkovTest, RunForMatchesStepwiseRun) {
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    markov->SetHistoryCaptureInterval(520);
+    markov->SetFinalTimestep(5201);
+    markov->Finalize();
+    auto stepwise = markov->clone();
+
+    markov->RunFor(5201);
+    for (int step = 0; step < 5201; ++step) {
+        stepwise->RunTransitions();
+    }
+    EXPECT_TRUE(markov->GetState().isApprox(stepwise->GetState(), 1e-9));
+    ExpectHistoriesNear(markov->GetHistories(), stepwise->GetHistories());
+}
+
+TEST_F(MarkovTest, RunForComposesRecordedAdmissions) {
+    // state 0 only loses people and state 1 only gains them, so admissions
+    // are linear in the state and the default histories can fast-forward
+    Eigen::MatrixXd admit(3, 3);
+    admit << 0.7, 0.0, 0.0, 0.3, 1.0, 0.0, 0.0, 0.0, 1.0;
+    auto intervention =
+        TransitionFactory::CreateTransition("intervention", "test_logger");
+    intervention->AddTransitionMatrix(admit);
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    markov->AddTransition(intervention);
+    markov->SetHistoryCaptureInterval(520);
+    markov->Finalize();
+    auto stepwise = markov->clone();
+
+    markov->RunFor(5200);
+    for (int step = 0; step < 5200; ++step) {
+        stepwise->RunTransitions();
+    }
+    // the composed map rounds differently from stepping
+    EXPECT_NE(markov->GetState(), stepwise->GetState());
+    EXPECT_TRUE(markov->GetState().isApprox(stepwise->GetState(), 1e-9));
+    ExpectHistoriesNear(markov->GetHistories(), stepwise->GetHistories());
+}
+
+TEST_F(MarkovTest, RunForFallsBackWhenMigrationCouldClamp) {
+    markov->SetState(state);
+    AddAffineChain(*markov, -0.5);
+    markov->SetHistoryCaptureInterval(100);
+    markov->Finalize();
+    auto stepwise = markov->clone();
+
+    markov->RunFor(1000);
+    for (int step = 0; step < 1000; ++step) {
+        stepwise->RunTransitions();
+    }
+    EXPECT_EQ(markov->GetState(), stepwise->GetState());
+    EXPECT_EQ(markov->GetHistories(), stepwise->GetHistories());
+}
+
+TEST_F(MarkovTest, RunForSwitchesSegmentsAtChangeTimes) {
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.001));
+    death->AddChangeTime(1500);
+    death->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.002));
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    markov->AddTransition(death);
+    markov->SetHistoryCaptureInterval(1000);
+    markov->Finalize();
+    auto stepwise = markov->clone();
+
+    markov->RunFor(3000);
+    for (int step = 0; step < 3000; ++step) {
+        stepwise->RunTransitions();
+    }
+    EXPECT_TRUE(markov->GetState().isApprox(stepwise->GetState(), 1e-9));
+    ExpectHistoriesNear(markov->GetHistories(), stepwise->GetHistories());
+}
+
+TEST_F(MarkovTest, ProjectMatchesStepwiseRun) {
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    markov->SetHistoryCaptureInterval(520);
+    markov->Finalize();
+
+    const auto projection = markov->Project(520);
+    EXPECT_EQ(markov->GetState(), state);
+    for (int step = 0; step < 520; ++step) {
+        markov->RunTransitions();
+    }
+    EXPECT_TRUE(projection.state.isApprox(markov->GetState(), 1e-9));
+    const auto histories = markov->GetHistories();
+    for (const auto &name :
+         {"total_overdose", "fatal_overdose", "background_death"}) {
+        EXPECT_TRUE(projection.outcomes.at(name).isApprox(
+            histories.at(name).GetRecordedStates().back(), 1e-9))
+            << name;
+    }
+}
+
+TEST_F(MarkovTest, ProjectHandlesDefectiveAndScheduledChains) {
+    // a Jordan block has no eigenbasis, so the closed form must not be used
+    Eigen::MatrixXd defective(3, 3);
+    defective << 0.5, 0.5, 0.0, 0.0, 0.5, 0.0, 0.0, 0.0, 1.0;
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(defective);
+    behavior->AddChangeTime(10);
+    behavior->AddTransitionMatrix(Eigen::MatrixXd::Identity(3, 3));
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.01));
+    markov->SetState(state);
+    markov->AddTransition(behavior);
+    markov->AddTransition(death);
+    markov->SetHistoryCaptureInterval(30);
+    markov->Finalize();
+
+    const auto projection = markov->Project(30);
+    for (int step = 0; step < 30; ++step) {
+        markov->RunTransitions();
+    }
+    EXPECT_TRUE(projection.state.isApprox(markov->GetState(), 1e-9));
+    EXPECT_TRUE(projection.outcomes.at("background_death")
+                    .isApprox(markov->GetHistories()
+                                  .at("background_death")
+                                  .GetRecordedStates()
+                                  .back(),
+                              1e-9));
+}
+
+TEST_F(MarkovTest, ConcurrentProjectionsLeaveSchedulesAlone) {
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(Eigen::MatrixXd::Identity(3, 3));
+    for (int change_time = 5; change_time < 40; change_time += 5) {
+        behavior->AddChangeTime(change_time);
+        behavior->AddTransitionMatrix(Eigen::MatrixXd::Identity(3, 3) *
+                                      (1.0 - change_time / 100.0));
+    }
+    const Transition *scheduled = behavior.get();
+    markov->SetState(state);
+    markov->AddTransition(std::move(behavior));
+    markov->Finalize();
+    for (int step = 0; step < 7; ++step) {
+        markov->RunTransitions();
+    }
+    const Eigen::MatrixXd active = scheduled->CopyTransitionMatrices()[0];
+    const auto expected = markov->Project(30);
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (std::size_t i = 0; i < mismatches.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            for (int k = 0; k < 25; ++k) {
+                const auto projection = markov->Project(30);
+                if (!projection.state.isApprox(expected.state)) {
+                    ++mismatches[i];
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches, std::vector<int>(mismatches.size(), 0));
+    // the model's own transition still has the segment of timestep 7
+    EXPECT_EQ(scheduled->CopyTransitionMatrices()[0], active);
+}
+
+TEST_F(MarkovTest, ProjectRequiresFinalizedModel) {
+    markov->SetState(state);
+    EXPECT_THROW(markov->Project(10), std::runtime_error);
+}
+
+TEST_F(MarkovTest, RunUntilConvergedStopsAtEquilibrium) {
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    markov->SetHistoryCaptureInterval(52);
+    markov->Finalize();
+
+    const auto result = markov->RunUntilConverged(100000, 1e-10);
+    EXPECT_TRUE(result.converged);
+    EXPECT_GT(result.steps, 1);
+    EXPECT_LT(result.steps, 100000);
+    EXPECT_LE(result.change, 1e-10);
+    EXPECT_TRUE(markov->GetState().isApprox(markov->SolveEquilibrium(), 1e-6));
+}
+
+TEST_F(MarkovTest, RunUntilConvergedStopsAtStepLimit) {
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    const auto result = markov->RunUntilConverged(5, 1e-10);
+    EXPECT_FALSE(result.converged);
+    EXPECT_EQ(result.steps, 5);
+    EXPECT_GT(result.change, 1e-10);
+}
+
+TEST_F(MarkovTest, SolveEquilibriumKeepsPopulationOfClosedChain) {
+    Eigen::MatrixXd behavior_matrix(3, 3);
+    behavior_matrix << 0.8, 0.1, 0.0, 0.2, 0.8, 0.1, 0.0, 0.1, 0.9;
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(behavior_matrix);
+    markov->SetState(state);
+    markov->AddTransition(behavior);
+    markov->Finalize();
+
+    const Eigen::VectorXd equilibrium = markov->SolveEquilibrium();
+    EXPECT_NEAR(equilibrium.sum(), state.sum(), 1e-12);
+    EXPECT_TRUE((behavior_matrix * equilibrium).isApprox(equilibrium));
+}
+
+TEST_F(MarkovTest, SolveEquilibriumRejectsClampingChain) {
+    markov->SetState(state);
+    AddAffineChain(*markov, -0.5);
+    markov->Finalize();
+    EXPECT_THROW(markov->SolveEquilibrium(), std::runtime_error);
+}
+
+TEST_F(MarkovTest, CloneOfFinalizedModelOutlivesOriginal) {
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    auto checked = markov->clone();
+    markov->Finalize();
+    auto copy = markov->clone();
+    EXPECT_TRUE(copy->IsFinalized());
+
+    // the copy's plan must not depend on the original's transitions
+    markov.reset();
+    for (int step = 0; step < 3; ++step) {
+        copy->RunTransitions();
+        checked->RunTransitions();
+    }
+    EXPECT_TRUE(copy->GetState().isApprox(checked->GetState()));
+    EXPECT_EQ(copy->GetHistories(), checked->GetHistories());
+}
+
+TEST_F(MarkovTest, ForkContinuesLikeClone) {
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    markov->Finalize();
+    for (int step = 0; step < 4; ++step) {
+        markov->RunTransitions();
+    }
+    auto reference = markov->clone();
+    auto branch = markov->Fork();
+    EXPECT_TRUE(branch->IsFinalized());
+    EXPECT_EQ(branch->GetHistories(), reference->GetHistories());
+
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+        branch->RunTransitions();
+        reference->RunTransitions();
+    }
+    EXPECT_EQ(markov->GetHistories(), reference->GetHistories());
+    EXPECT_EQ(branch->GetHistories(), reference->GetHistories());
+
+    // branches of a branch stack their prefixes
+    auto nested = branch->Fork();
+    branch.reset();
+    for (int step = 0; step < 2; ++step) {
+        nested->RunTransitions();
+        reference->RunTransitions();
+    }
+    EXPECT_EQ(nested->GetState(), reference->GetState());
+    EXPECT_EQ(nested->GetHistories(), reference->GetHistories());
+}
+
+TEST_F(MarkovTest, ForkedBranchesDivergeAfterForkPoint) {
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+    }
+    auto branch = markov->Fork();
+    branch->ClearTransitions();
+    AddAffineChain(*branch, 2.0);
+    for (int step = 0; step < 2; ++step) {
+        markov->RunTransitions();
+        branch->RunTransitions();
+    }
+
+    const auto baseline = markov->GetHistories().at("state").GetStateMap();
+    const auto scenario = branch->GetHistories().at("state").GetStateMap();
+    ASSERT_EQ(scenario.size(), 6u);
+    for (int timestep = 0; timestep <= 3; ++timestep) {
+        EXPECT_EQ(scenario.at(timestep), baseline.at(timestep));
+    }
+    EXPECT_GT(scenario.at(5).sum(), baseline.at(5).sum());
+
+    // replacing the histories drops the shared prefix
+    branch->SetHistories({});
+    EXPECT_TRUE(branch->GetHistories().empty());
+}
+
+std::unique_ptr<Transition> MakeScheduledOverdose(int change_time,
+                                                  double later_rate) {
+    auto overdose =
+        TransitionFactory::CreateTransition("overdose", "test_logger");
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.01));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.2));
+    overdose->AddChangeTime(change_time);
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, later_rate));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.2));
+    return overdose;
+}
+
+TEST_F(MarkovTest, ReplaceTransitionMatchesFreshRun) {
+    markov->SetState(state);
+    AddAffineChain(*markov, 0.5);
+    markov->SetCheckpointing(true);
+    auto fresh = markov->clone();
+    markov->Finalize();
+    markov->RunFor(20);
+
+    // the first replacement resumes from the start of the run, the second
+    // from the checkpoint at the change time the first one introduced
+    for (double rate : {0.05, 0.02}) {
+        markov->ReplaceTransition(1, MakeScheduledOverdose(8, rate), 8);
+        fresh->ReplaceTransition(1, MakeScheduledOverdose(8, rate), 8);
+        auto expected = fresh->clone();
+        expected->Finalize();
+        expected->RunFor(20);
+        EXPECT_TRUE(markov->IsFinalized());
+        EXPECT_TRUE(markov->GetState().isApprox(expected->GetState(), 1e-9));
+        ExpectHistoriesNear(markov->GetHistories(),
+                            expected->GetHistories());
+    }
+}
+
+TEST_F(MarkovTest, ReplaceTransitionResumesFromCheckpoint) {
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(Eigen::MatrixXd::Identity(3, 3));
+    behavior->AddChangeTime(10);
+    behavior->AddTransitionMatrix(Eigen::MatrixXd::Identity(3, 3));
+    auto identity = ::testing::Invoke(
+        [](const Eigen::Ref<const Eigen::VectorXd> &s,
+           std::map<std::string, History> &) { return Eigen::VectorXd(s); });
+    auto original = std::make_unique<NiceMock<MockTransition>>();
+    ON_CALL(*original, Execute(_, _)).WillByDefault(identity);
+    auto replacement = std::make_unique<NiceMock<MockTransition>>();
+    EXPECT_CALL(*replacement, Execute(_, _)).Times(5).WillRepeatedly(identity);
+
+    markov->SetState(state);
+    markov->SetCheckpointing(true);
+    markov->AddTransition(behavior);
+    markov->AddTransition(std::move(original));
+    for (int step = 0; step < 15; ++step) {
+        markov->RunTransitions();
+    }
+
+    // only the five steps after the checkpoint at timestep 10 run again
+    markov->ReplaceTransition(1, std::move(replacement), 12);
+    EXPECT_EQ(markov->GetState(), state);
+    const auto records = markov->GetHistories().at("state");
+    EXPECT_EQ(records.GetRecordedTimesteps().size(), 16u);
+    EXPECT_EQ(records.GetLatestRecordedTimestep(), 15);
+
+    markov->SetCheckpointing(false);
+    EXPECT_THROW(markov->ReplaceTransition(0, behavior->clone(), 12),
+                 std::runtime_error);
+    EXPECT_THROW(markov->ReplaceTransition(2, behavior->clone(), 20),
+                 std::runtime_error);
+}
+
+TEST_F(MarkovTest, StochasticRunIsReproduciblePerKey) {
+    Eigen::VectorXd people(3);
+    people << 1000.0, 500.0, 250.0;
+    markov->SetState(people);
+    AddAffineChain(*markov, 0.0);
+    markov->SetExecutionMode(ExecutionMode::kStochastic, {7, 0});
+    auto replay = markov->clone();
+    auto replicate = markov->clone();
+    replicate->SetExecutionMode(ExecutionMode::kStochastic, {7, 1});
+    markov->Finalize();
+    markov->RunFor(20);
+    for (int step = 0; step < 20; ++step) {
+        replay->RunTransitions();
+        replicate->RunTransitions();
+    }
+    EXPECT_EQ(replay->GetExecutionMode(), ExecutionMode::kStochastic);
+    EXPECT_EQ(markov->GetState(), replay->GetState());
+    EXPECT_EQ(markov->GetHistories(), replay->GetHistories());
+    EXPECT_NE(markov->GetState(), replicate->GetState());
+
+    // everyone not dead is still there, as whole people
+    const auto final_state = markov->GetState();
+    EXPECT_TRUE((final_state.array() == final_state.array().floor()).all());
+    const auto histories = markov->GetHistories();
+    double died = 0.0;
+    for (auto name : {"fatal_overdose", "background_death"}) {
+        for (const auto &s : histories.at(name).GetRecordedStates()) {
+            died += s.sum();
+        }
+    }
+    EXPECT_DOUBLE_EQ(final_state.sum() + died, people.sum());
+}
+
+TEST_F(MarkovTest, StochasticBatchUsesCommonRandomNumbers) {
+    Eigen::VectorXd people(3);
+    people << 1000.0, 500.0, 250.0;
+    markov->SetState(people);
+    AddAffineChain(*markov, 0.0);
+    markov->SetExecutionMode(ExecutionMode::kStochastic, {3, 0});
+    auto batched = markov->clone();
+    batched->SetBatchState(people.replicate(1, 2));
+    for (int step = 0; step < 5; ++step) {
+        markov->RunTransitions();
+        batched->RunTransitions();
+    }
+    EXPECT_EQ(batched->GetBatchState().col(0), markov->GetState());
+    EXPECT_EQ(batched->GetBatchState().col(1), markov->GetState());
+}
+
+TEST_F(MarkovTest, StochasticMeanTracksExpectedValue) {
+    markov->SetState(Eigen::VectorXd::Constant(3, 1e7));
+    AddAffineChain(*markov, 0.0);
+    auto expected = markov->clone();
+    markov->SetExecutionMode(ExecutionMode::kStochastic, {1, 0});
+    for (int step = 0; step < 5; ++step) {
+        markov->RunTransitions();
+        expected->RunTransitions();
+    }
+    EXPECT_TRUE(markov->GetState().isApprox(expected->GetState(), 1e-2));
+}
+
+TEST_F(MarkovTest, BatchedRunMatchesPerScenarioRuns) {
+    Eigen::MatrixXd behavior_matrix(3, 3);
+    behavior_matrix << 0.8, 0.1, 0.0, 0.2, 0.8, 0.1, 0.0, 0.1, 0.9;
+    auto behavior =
+        TransitionFactory::CreateTransition("behavior", "test_logger");
+    behavior->AddTransitionMatrix(behavior_matrix);
+    auto intervention =
+        TransitionFactory::CreateTransition("intervention", "test_logger");
+    intervention->AddTransitionMatrix(behavior_matrix.transpose());
+    auto overdose =
+        TransitionFactory::CreateTransition("overdose", "test_logger");
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.1));
+    overdose->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.2));
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Constant(3, 0.01));
+    markov->AddTransition(behavior);
+    markov->AddTransition(intervention);
+    markov->AddTransition(overdose);
+    markov->AddTransition(death);
+
+    Eigen::MatrixXd scenarios(3, 3);
+    scenarios.col(0) = state;
+    scenarios.col(1) = state.reverse();
+    scenarios.col(2) = state * 10.0;
+    auto single = markov->clone();
+    markov->SetBatchState(scenarios);
+    ASSERT_TRUE(markov->IsBatched());
+    for (int step = 0; step < 3; ++step) {
+        markov->RunTransitions();
+    }
+
+    const auto batch_histories = markov->GetBatchHistories();
+    ASSERT_EQ(batch_histories.size(), 3u);
+    for (Eigen::Index k = 0; k < scenarios.cols(); ++k) {
+        auto scenario = single->clone();
+        scenario->SetState(scenarios.col(k));
+        for (int step = 0; step < 3; ++step) {
+            scenario->RunTransitions();
+        }
+        EXPECT_TRUE(
+            markov->GetBatchState().col(k).isApprox(scenario->GetState()));
+        EXPECT_EQ(batch_histories[k], scenario->GetHistories());
+    }
+
+    markov->SetState(state);
+    EXPECT_FALSE(markov->IsBatched());
+}
+
+TEST_F(MarkovTest, ChangesInvalidateFinalizedPlan) {
+    markov->SetState(state);
+    markov->Finalize();
+    ASSERT_TRUE(markov->IsFinalized());
+
+    // same shape, non-negative: the plan is kept
+    markov->SetState(state * 2.0);
+    EXPECT_TRUE(markov->IsFinalized());
+
+    markov->SetState(Eigen::VectorXd::Ones(4));
+    EXPECT_FALSE(markov->IsFinalized());
+
+    markov->Finalize();
+    auto death =
+        TransitionFactory::CreateTransition("background_death", "test_logger");
+    death->AddTransitionMatrix(Eigen::VectorXd::Zero(4));
+    markov->AddTransition(death);
+    EXPECT_FALSE(markov->IsFinalized());
+}
+
 TEST_F(MarkovTest, ModelName) { ASSERT_EQ(markov->GetModelName(), "markov"); }
 
 TEST_F(MarkovTest, LogName) { ASSERT_EQ(markov->GetLogName(), "test_logger"); }
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-06                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-05-06                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -128,5 +128,60 @@ TEST_F(OverdoseTest, GoodExecuteWriteAllHistory) {
     EXPECT_TRUE(histories["fatal_overdose"].GetPendingState().isApprox(fods));
     EXPECT_TRUE(result.isApprox(expected_return));
 }
+
+TEST_F(OverdoseTest, ExecuteIntoMatchesExecute) {
+    History h("total_overdose", "test_logger");
+    histories["total_overdose"] = h;
+    tran->AddTransitionMatrix(tran_matrix);
+    tran->AddTransitionMatrix(tran_matrix);
+    ExecutionContext ctx(histories);
+    Eigen::VectorXd out;
+    tran->ExecuteInto(state, out, ctx);
+
+    auto overdoses = state.cwiseProduct(tran_matrix);
+    auto expected_return = state - overdoses.cwiseProduct(tran_matrix);
+    EXPECT_TRUE(out.isApprox(expected_return));
+    EXPECT_TRUE(
+        histories["total_overdose"].GetPendingState().isApprox(overdoses));
+}
+
+TEST_F(OverdoseTest, ExecuteBatchMatchesExecutePerColumn) {
+    tran->AddTransitionMatrix(tran_matrix);
+    tran->AddTransitionMatrix(tran_matrix);
+    Eigen::MatrixXd states(3, 2);
+    states.col(0) = state;
+    states.col(1) = state * 4.0;
+    histories["total_overdose"] = History("total_overdose", "test_logger");
+    std::vector<std::map<std::string, History>> batch(2, histories);
+    BatchExecutionContext ctx(batch);
+    Eigen::MatrixXd out;
+    tran->ExecuteBatch(states, out, ctx);
+
+    for (Eigen::Index k = 0; k < states.cols(); ++k) {
+        std::map<std::string, History> expected_histories = histories;
+        auto expected = tran->Execute(states.col(k), expected_histories);
+        EXPECT_TRUE(out.col(k).isApprox(expected));
+        EXPECT_EQ(batch[k], expected_histories);
+    }
+}
+TEST_F(OverdoseTest, ExecuteBatchBorrowsResolvedSlots) {
+    tran->AddTransitionMatrix(tran_matrix);
+    tran->AddTransitionMatrix(tran_matrix);
+    Eigen::MatrixXd states(3, 2);
+    states.col(0) = state;
+    states.col(1) = state * 4.0;
+    histories["total_overdose"] = History("total_overdose", "test_logger");
+    std::vector<std::map<std::string, History>> batch(2, histories);
+    std::vector<HistorySlots> slots(batch.begin(), batch.end());
+    BatchExecutionContext ctx(batch, slots);
+    EXPECT_EQ(&ctx.slots, &slots);
+    Eigen::MatrixXd out;
+    tran->ExecuteBatch(states, out, ctx);
+
+    for (Eigen::Index k = 0; k < states.cols(); ++k) {
+        EXPECT_TRUE(batch[k]["total_overdose"].GetPendingState().isApprox(
+            states.col(k).cwiseProduct(tran_matrix)));
+    }
+}
 } // namespace testing
 } // namespace respond
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: random_test.cpp                                                      //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <respond/random.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+namespace respond {
+namespace testing {
+
+TEST(RandomTest, PhiloxMatchesReferenceVectors) {
+    // known-answer vectors of the Random123 reference implementation
+    using Block = std::array<std::uint32_t, 4>;
+    EXPECT_EQ(Philox4x32({0, 0, 0, 0}, {0, 0}),
+              (Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(Philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                         {0xffffffff, 0xffffffff}),
+              (Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(Philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                         {0xa4093822, 0x299f31d0}),
+              (Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(RandomTest, StreamsDependOnlyOnTheirCoordinates) {
+    const RandomKey key{42, 3};
+    auto first = key.Stream(5, 1, 7);
+    auto neighbour = key.Stream(5, 1, 8);
+    const double a = first.Uniform();
+    const double b = first.Uniform();
+    const double c = first.Uniform();
+    EXPECT_GT(a, 0.0);
+    EXPECT_LT(a, 1.0);
+    EXPECT_NE(a, neighbour.Uniform());
+
+    auto again = key.Stream(5, 1, 7);
+    EXPECT_EQ(again.Uniform(), a);
+    EXPECT_EQ(again.Uniform(), b);
+    EXPECT_EQ(again.Uniform(), c);
+    EXPECT_NE(RandomKey({42, 4}).Stream(5, 1, 7).Uniform(), a);
+}
+
+TEST(RandomTest, BinomialHandlesDegenerateParameters) {
+    auto stream = RandomKey().Stream(0, 0, 0);
+    EXPECT_EQ(SampleBinomial(10.0, 0.0, stream), 0.0);
+    EXPECT_EQ(SampleBinomial(10.0, 1.0, stream), 10.0);
+    EXPECT_EQ(SampleBinomial(3.7, 1.0, stream), 3.0);
+    EXPECT_EQ(SampleBinomial(0.0, 0.5, stream), 0.0);
+    EXPECT_EQ(SampleBinomial(-2.0, 0.5, stream), 0.0);
+}
+
+TEST(RandomTest, BinomialMomentsMatchDistribution) {
+    // inversion, inversion of the complement, and rejection sampling
+    constexpr int kDraws = 20000;
+    for (auto [trials, probability] :
+         {std::tuple{20.0, 0.1}, std::tuple{20.0, 0.9},
+          std::tuple{50.0, 0.2}, std::tuple{1e4, 0.3},
+          std::tuple{1e6, 0.75}}) {
+        const RandomKey key{11, 0};
+        double sum = 0.0;
+        double squares = 0.0;
+        for (int i = 0; i < kDraws; ++i) {
+            auto stream = key.Stream(0, 0, i);
+            const double k = SampleBinomial(trials, probability, stream);
+            ASSERT_GE(k, 0.0);
+            ASSERT_LE(k, trials);
+            ASSERT_EQ(k, std::floor(k));
+            sum += k;
+            squares += k * k;
+        }
+        const double mean = sum / kDraws;
+        const double variance = squares / kDraws - mean * mean;
+        const double expected_variance =
+            trials * probability * (1.0 - probability);
+        EXPECT_NEAR(mean, trials * probability,
+                    5.0 * std::sqrt(expected_variance / kDraws))
+            << trials << " trials at " << probability;
+        EXPECT_NEAR(variance / expected_variance, 1.0, 0.1)
+            << trials << " trials at " << probability;
+    }
+}
+
+} // namespace testing
+} // namespace respond
@@ -4,7 +4,7 @@
 // Created Date: 2026-02-09                                                   //
 // Author: Matthew Carroll                                                    //
 // -----                                                                      //
-// Last Modified: 2026-02-12                                                  //
+// Last Modified: 2026-10-17                                                  //
 // Modified By: Matthew Carroll                                               //
 // -----                                                                      //
 // Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
@@ -14,6 +14,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -49,6 +52,19 @@ TEST_F(SimulationTest, GetSetModel) {
     ASSERT_EQ(s.GetModels().size(), 1);
 }
 
+TEST_F(SimulationTest, AddModelTakesOwnershipOfTemporaries) {
+    auto mock = std::make_unique<NiceMock<MockModel>>();
+    EXPECT_CALL(*mock, clone()).Times(0);
+    const Model *raw = mock.get();
+
+    std::unique_ptr<Model> upmm = std::move(mock);
+    Simulation s;
+    s.AddModel(std::move(upmm));
+    EXPECT_EQ(upmm, nullptr);
+    ASSERT_EQ(s.GetModels().size(), 1);
+    EXPECT_EQ(s.GetModels()[0].get(), raw);
+}
+
 TEST_F(SimulationTest, ClearModels) {
     auto mock = std::make_unique<NiceMock<MockModel>>();
     auto cloned = std::make_unique<NiceMock<MockModel>>();
@@ -107,6 +123,23 @@ TEST_F(SimulationTest, GetModelHistories) {
     ASSERT_EQ(s.GetModelHistories(), expected);
 }
 
+TEST_F(SimulationTest, GetModelHistoriesStitchesForkedPrefix) {
+    auto model = Model::Create("baseline", "test_logger");
+    model->SetState(Eigen::VectorXd::Ones(2));
+    for (int step = 0; step < 3; ++step) {
+        model->RunTransitions();
+    }
+    Simulation s;
+    s.AddModel(model->Fork());
+    s.AddModel(std::move(model));
+    s.Run();
+
+    const auto histories = s.GetModelHistories();
+    ASSERT_EQ(histories.size(), 2u);
+    EXPECT_EQ(histories[0].at("state").size(), 5u);
+    EXPECT_EQ(histories[0], histories[1]);
+}
+
 TEST_F(SimulationTest, GetHistoryNames) {
     auto mock = std::make_unique<NiceMock<MockModel>>();
     auto cloned = std::make_unique<NiceMock<MockModel>>();
@@ -165,5 +198,83 @@ TEST_F(SimulationTest, GetModelSparseHistories) {
     EXPECT_TRUE(history.GetRecordedStates()[1].isApprox(state2));
 }
 
+TEST_F(SimulationTest, ThreadingPolicyStaysWithinHardware) {
+    const int cores = ThreadingPolicy::GetHardwareThreads();
+    ThreadingPolicy oversubscribed(1000, 1000);
+    EXPECT_LE(oversubscribed.GetIntraOpThreads(), cores);
+    EXPECT_LE(oversubscribed.GetIntraOpThreads() *
+                  oversubscribed.GetModelWorkers(),
+              cores);
+
+    ThreadingPolicy empty(0, 0);
+    EXPECT_EQ(empty.GetIntraOpThreads(), 1);
+    EXPECT_EQ(empty.GetModelWorkers(), 1);
+
+    EXPECT_EQ(ThreadingPolicy::ModelParallel().GetModelWorkers(), cores);
+    Simulation s;
+    EXPECT_EQ(s.GetThreadingPolicy().GetModelWorkers(), 1);
+}
+
+TEST_F(SimulationTest, RunStepsEveryModelOnceWithWorkers) {
+    Simulation s;
+    s.SetThreadingPolicy(ThreadingPolicy::ModelParallel());
+    for (int m = 0; m < 5; ++m) {
+        auto mock = std::make_unique<NiceMock<MockModel>>();
+        auto cloned = std::make_unique<NiceMock<MockModel>>();
+        EXPECT_CALL(*cloned, RunTransitions()).Times(1);
+        EXPECT_CALL(*mock, clone())
+            .WillOnce(Return(::testing::ByMove(std::move(cloned))));
+        std::unique_ptr<Model> upmm = std::move(mock);
+        s.AddModel(upmm);
+    }
+    s.Run();
+}
+
+TEST_F(SimulationTest, WorkerPoolReusesItsThreadsAcrossRuns) {
+    WorkerPool pool(4);
+    ASSERT_EQ(pool.size(), 4u);
+    std::vector<std::thread::id> first(4);
+    pool.Run([&](std::size_t w) { first[w] = std::this_thread::get_id(); });
+    EXPECT_EQ(first[0], std::this_thread::get_id());
+
+    std::vector<int> runs(4, 0);
+    std::vector<std::thread::id> ids(4);
+    for (int step = 0; step < 1000; ++step) {
+        pool.Run([&](std::size_t w) {
+            ++runs[w];
+            ids[w] = std::this_thread::get_id();
+        });
+    }
+    EXPECT_EQ(runs, std::vector<int>(4, 1000));
+    EXPECT_EQ(ids, first);
+
+    // an error surfaces once and leaves the pool usable
+    auto failing = [](std::size_t w) {
+        if (w == 2) {
+            throw std::runtime_error("worker failed");
+        }
+    };
+    EXPECT_THROW(pool.Run(failing), std::runtime_error);
+    EXPECT_NO_THROW(pool.Run([](std::size_t) {}));
+}
+
+TEST_F(SimulationTest, RunRethrowsModelErrors) {
+    Simulation s;
+    s.SetThreadingPolicy(ThreadingPolicy::ModelParallel());
+    for (int m = 0; m < 3; ++m) {
+        auto mock = std::make_unique<NiceMock<MockModel>>();
+        auto cloned = std::make_unique<NiceMock<MockModel>>();
+        if (m == 1) {
+            EXPECT_CALL(*cloned, RunTransitions())
+                .WillOnce(::testing::Throw(std::runtime_error("step failed")));
+        }
+        EXPECT_CALL(*mock, clone())
+            .WillOnce(Return(::testing::ByMove(std::move(cloned))));
+        std::unique_ptr<Model> upmm = std::move(mock);
+        s.AddModel(upmm);
+    }
+    EXPECT_THROW(s.Run(), std::runtime_error);
+}
+
 } // namespace testing
 } // namespace respond
\ No newline at end of file
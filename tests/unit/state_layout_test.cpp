@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+// File: state_layout_test.cpp                                                //
+// Project: respond                                                           //
+// Created Date: 2026-10-17                                                   //
+// Author: Matthew Carroll                                                    //
+// -----                                                                      //
+// Last Modified: 2026-10-17                                                  //
+// Modified By: Matthew Carroll                                               //
+// -----                                                                      //
+// Copyright (c) 2026 Syndemics Lab at Boston Medical Center                  //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <respond/state_layout.hpp>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+namespace respond {
+namespace testing {
+
+TEST(StateLayoutTest, EmptyLayout) {
+    StateLayout layout;
+    EXPECT_EQ(layout.Size(), 0);
+    EXPECT_EQ(layout.AxisCount(), 0u);
+}
+
+TEST(StateLayoutTest, SizesAndStrides) {
+    StateLayout layout({{"intervention", 13}, {"behavior", 5}, {"age", 4}});
+    EXPECT_EQ(layout.Size(), 260);
+    EXPECT_EQ(layout.Stride(0), 20);
+    EXPECT_EQ(layout.Stride(1), 4);
+    EXPECT_EQ(layout.Stride(2), 1);
+    EXPECT_EQ(layout.FindAxis("behavior"), 1u);
+    EXPECT_EQ(layout.FindAxis("sex"), layout.AxisCount());
+    EXPECT_EQ(layout.AxisName(2), "age");
+    EXPECT_EQ(layout.AxisSize(0), 13);
+}
+
+TEST(StateLayoutTest, RejectsEmptyAxis) {
+    EXPECT_THROW(StateLayout({{"behavior", 0}}, "test_logger"),
+                 std::runtime_error);
+}
+
+TEST(StateLayoutTest, RejectsDuplicateAxis) {
+    EXPECT_THROW(StateLayout({{"behavior", 5}, {"behavior", 5}}, "test_logger"),
+                 std::runtime_error);
+}
+} // namespace testing
+} // namespace respond